@@ -25,37 +25,663 @@
 ## POSSIBILITY OF SUCH DAMAGE.
 ##========================================================================== //
 
-MACRO(EMIT_ANSWER ANSWER)
-  SET(VERILATED_OBJ "${CMAKE_CURRENT_BINARY_DIR}/obj")
-  SET(VERILATED_LIB "${VERILATED_OBJ}/V${ANSWER}__ALL.a")
+INCLUDE(CMakeParseArguments)
+
+# Additional options passed verbatim to Verilator for every answer. Previously
+# picked up from the environment at build time, the value is now captured at
+# configuration time so that changes to it are visible to the dependency graph.
+#
+SET(VERILATOR_OPTIONS "$ENV{VERILATOR_OPTIONS}"
+  CACHE STRING "Additional options passed to Verilator")
+
+# Each answer is built twice: a debug model with full tracing instrumentation
+# and a 'fast' model, without tracing, for use in throughput regressions. A
+# failing seed found by the fast model can be re-run on the traced model.
+#
+OPTION(BUILD_FAST_MODELS "Emit trace-free, optimized <answer>_fast targets" ON)
+SET(VERILATOR_DEBUG_FLAGS "--trace-fst --trace-structs --trace-threads 1"
+  CACHE STRING "Verilator options for the (default) debug model")
+SET(VERILATOR_FAST_FLAGS "-O3 --x-assign fast --x-initial fast"
+  CACHE STRING "Verilator options for the <answer>_fast model")
+SET(VERILATOR_FAST_CFLAGS "-O3 -march=native"
+  CACHE STRING "C++ compiler options for the <answer>_fast model")
+
+# Minimum report level (DEBUG or INFO) compiled into the testbench. At INFO,
+# debug reports (LIBTBX_REPORT_DEBUG) are removed, along with the formatting of
+# their messages; information, warnings and errors are always reported. By
+# default, debug reports are retained only by the debug model.
+#
+SET(REPORT_MIN_LEVEL "DEBUG"
+  CACHE STRING "Minimum report level of the (default) debug model")
+SET(FAST_REPORT_MIN_LEVEL "INFO"
+  CACHE STRING "Minimum report level of all other models")
+FOREACH(__level REPORT_MIN_LEVEL FAST_REPORT_MIN_LEVEL)
+  SET_PROPERTY(CACHE ${__level} PROPERTY STRINGS DEBUG INFO)
+  IF(NOT ${__level} MATCHES "^(DEBUG|INFO)$")
+    MESSAGE(FATAL_ERROR "${__level} must be DEBUG or INFO")
+  ENDIF()
+ENDFOREACH()
+
+# Thread counts at which answers marked BENCH_THREADS are benchmarked.
+#
+SET(BENCH_THREADS_COUNTS "1;2;4;8"
+  CACHE STRING "Verilator thread counts swept by the bench_threads target")
+
+# Counter counts at which lockstep testbenches (EMIT_LOCKSTEP) are emitted.
+#
+SET(LOCKSTEP_SIZES "32;256;1024"
+  CACHE STRING "Sizes swept by lockstep testbenches (EMIT_LOCKSTEP)")
+
+# Multi-seed regression. The top-level target 'regress' runs REGRESS_SEEDS seeds
+# of each answer in REGRESS_ANSWERS (default: all answers) across REGRESS_JOBS
+# concurrent simulations (default: number of cores) using the fast model, where
+# built. Answers in REGRESS_LONGEST_FIRST are scheduled ahead of all others
+# until a previous regression has recorded their run times.
+#
+SET(REGRESS_ANSWERS ""
+  CACHE STRING "Answers run by the regress target (default: all)")
+SET(REGRESS_LONGEST_FIRST "sorted_lists;multi_counter_variants"
+  CACHE STRING "Answers scheduled first by the regress target")
+SET(REGRESS_SEEDS 100
+  CACHE STRING "Number of seeds per answer run by the regress target")
+SET(REGRESS_JOBS 0
+  CACHE STRING "Concurrent simulations run by the regress target (0: cores)")
+
+# Profile-guided optimization. When enabled, each answer additionally emits
+# <answer>_pgo: the <answer>_fast model and testbench rebuilt using the profile
+# gathered by running an instrumented build (<answer>_pgo_gen) of the answer's
+# own test. Profiles are transferred between builds as GCC .gcda files, one per
+# object.
+#
+OPTION(BUILD_PGO_MODELS "Emit profile-guided <answer>_pgo targets" OFF)
+SET(PGO_GENERATE_FLAGS "-fprofile-generate"
+  CACHE STRING "C++ compiler options for the instrumented PGO build")
+SET(PGO_USE_FLAGS "-fprofile-use -fprofile-correction"
+  CACHE STRING "C++ compiler options for the profile-guided build")
+
+# Testbenches written upon coroutines (see <libtbx/coro.h>) are built as C++20
+# (which requires CMake 3.12). SystemC encodes the C++ standard of its own
+# build within its API version check, which these testbenches must therefore
+# be told explicitly.
+#
+SET(SYSTEMC_CPLUSPLUS "201103L"
+  CACHE STRING "Value of __cplusplus against which SystemC was built")
+
+# Write CONTENT to FILENAME only when it differs from the existing contents. The
+# file is used as a dependency of the verilation step, therefore it must retain
+# its timestamp when re-configuring with unchanged options.
+#
+MACRO(WRITE_IF_CHANGED FILENAME CONTENT)
+  SET(__write_if_changed_old "")
+  IF(EXISTS ${FILENAME})
+    FILE(READ ${FILENAME} __write_if_changed_old)
+  ENDIF()
+  IF(NOT "${__write_if_changed_old}" STREQUAL "${CONTENT}")
+    FILE(WRITE ${FILENAME} "${CONTENT}")
+  ENDIF()
+ENDMACRO()
+
+# Verilate ANSWER, from ${SOURCE_DIR}/${ANSWER}.sv, into VERILATED_OBJ. The
+# options passed to Verilator are recorded in FLAGS_FILE.
+#
+#   MODE     Verilator output mode (--sc or --cc).
+#   RUNTIME  Rebuild the Verilator runtime alongside the model.
+#   FLAGS    Verilator options (as a single string).
+#   CFLAGS   C++ compiler options for the generated model (as a single string).
+#   OUTPUTS  The files produced by the verilation step.
+#   DEPENDS  Additional dependencies of the verilation step.
+#   COMMENT  Message displayed upon verilation.
+#
+FUNCTION(VERILATE_MODEL ANSWER SOURCE_DIR VERILATED_OBJ FLAGS_FILE)
+  CMAKE_PARSE_ARGUMENTS(M "" "MODE;RUNTIME;FLAGS;CFLAGS;COMMENT"
+    "OUTPUTS;DEPENDS" ${ARGN})
+
   SET(VERILATOR_INCLUDE
-    "-I${Libv_VINCLUDE_DIRS} -I${CMAKE_CURRENT_SOURCE_DIR} -I${Libtb_VINCLUDE_DIRS} -I${LibpdTech_VINCLUDE_DIRS} -I${Libpd_VINCLUDE_DIRS}"
+    "-I${Libv_VINCLUDE_DIRS} -I${SOURCE_DIR} -I${Libtb_VINCLUDE_DIRS} -I${LibpdTech_VINCLUDE_DIRS} -I${Libpd_VINCLUDE_DIRS}"
+    )
+
+  # Verilation is a function of the SystemVerilog sources and packages visible
+  # on the include path, the verilation script itself and the options passed to
+  # Verilator. Any change to these forces the model to be rebuilt; otherwise
+  # the existing archive is retained.
+  #
+  FILE(GLOB VERILATED_DEPENDS
+    ${SOURCE_DIR}/*.sv
+    ${SOURCE_DIR}/*.vh
+    ${Libv_VINCLUDE_DIRS}/*.sv
+    ${Libv_VINCLUDE_DIRS}/*.vh
+    ${Libtb_VINCLUDE_DIRS}/*.sv
+    ${Libtb_VINCLUDE_DIRS}/*.vh
     )
-  ADD_CUSTOM_TARGET(
-    verilate
+  WRITE_IF_CHANGED(${FLAGS_FILE}
+    "${Verilator_EXE}\n${M_MODE}\n${VERILATOR_INCLUDE}\n${M_FLAGS}\n${VERILATOR_OPTIONS}\n${M_CFLAGS}\n")
+
+  ADD_CUSTOM_COMMAND(
+    OUTPUT ${M_OUTPUTS}
     COMMAND ${CMAKE_COMMAND} -E env
        ANSWER=${ANSWER}
        VERILATED_OBJ=${VERILATED_OBJ}
        VERILATOR_INCLUDE=${VERILATOR_INCLUDE}
        VERILATOR_EXE=${Verilator_EXE}
+       VERILATOR_MODE=${M_MODE}
+       VERILATOR_FLAGS=${M_FLAGS}
+       VERILATOR_OPTIONS=${VERILATOR_OPTIONS}
+       VERILATOR_CFLAGS=${M_CFLAGS}
+       VERILATOR_RUNTIME=${M_RUNTIME}
        SYSTEMC_INCLUDE=${SystemC_INCLUDE_DIR}
        SYSTEMC_LIBDIR=${SystemC_LIBRARY}
-       CMAKE_CURRENT_SOURCE_DIR=${CMAKE_CURRENT_SOURCE_DIR}
+       CMAKE_CURRENT_SOURCE_DIR=${SOURCE_DIR}
        ${CMAKE_SOURCE_DIR}/scripts/verilate.sh
+    DEPENDS
+       ${VERILATED_DEPENDS}
+       ${FLAGS_FILE}
+       ${CMAKE_SOURCE_DIR}/scripts/verilate.sh
+       ${M_DEPENDS}
+    COMMENT "${M_COMMENT}"
     )
-  ADD_EXECUTABLE(${ANSWER} ${ANSWER}.cpp)
-  ADD_DEPENDENCIES(${ANSWER} verilate)
-  TARGET_INCLUDE_DIRECTORIES(${ANSWER} PUBLIC
+ENDFUNCTION()
+
+# Verilate ANSWER into the object directory 'obj${SUFFIX}' and emit executable
+# TARGET from ${ANSWER}.cpp linked against the resultant model.
+#
+#   SOURCE   Build TARGET from SOURCE in place of ${ANSWER}.cpp.
+#   FLAGS    Verilator options specific to this variant.
+#   CFLAGS   C++ compiler options for the generated model and testbench.
+#   LINK_FLAGS
+#            Linker options for TARGET.
+#   DEPENDS  Additional dependencies of the verilation step.
+#   THREADS  Verilate a multithreaded model (--threads N). The Verilator
+#            runtime is then rebuilt alongside the model with VL_THREADED.
+#   REPORT_LEVEL
+#            Minimum report level compiled into the testbench.
+#   TRACE    The model is verilated with (FST) tracing instrumentation. The
+#            Verilator runtime, including the FST writer, is rebuilt alongside
+#            the model; should FLAGS include --trace-threads, the runtime is
+#            threaded.
+#   SAVABLE  The model is verilated with --savable, and the Verilator runtime
+#            (including verilated_save) rebuilt alongside it. The testbench
+#            is built with LIBTBX_SAVABLE (see <libtbx/checkpoint.h>).
+#   NATIVE   The model is verilated as plain C++ (--cc) and the testbench is
+#            built upon the native backend of libtbx (LIBTBX_BACKEND_NATIVE).
+#            The Verilator runtime is rebuilt alongside the model.
+#   COVERAGE The model is verilated with toggle coverage (--coverage-toggle),
+#            and the Verilator runtime (including verilated_cov) rebuilt
+#            alongside it. The testbench is built with VM_COVERAGE (see
+#            <libtbx/activity.h>).
+#   COROUTINES
+#            The testbench is built as C++20.
+#   EXCLUDE_FROM_ALL
+#            TARGET is not built by default.
+#
+FUNCTION(EMIT_ANSWER_VARIANT TARGET ANSWER SUFFIX)
+  CMAKE_PARSE_ARGUMENTS(V
+    "TRACE;NATIVE;SAVABLE;COVERAGE;COROUTINES;EXCLUDE_FROM_ALL"
+    "THREADS;REPORT_LEVEL;SOURCE"
+    "FLAGS;CFLAGS;LINK_FLAGS;DEPENDS" ${ARGN})
+
+  SET(SOURCE ${ANSWER}.cpp)
+  IF(V_SOURCE)
+    SET(SOURCE ${V_SOURCE})
+  ENDIF()
+
+  SET(VERILATED_OBJ "${CMAKE_CURRENT_BINARY_DIR}/obj${SUFFIX}")
+  SET(VERILATED_LIB "${VERILATED_OBJ}/V${ANSWER}__ALL.a")
+  SET(VERILATED_RT "${VERILATED_OBJ}/libverilated_rt.a")
+  STRING(REPLACE ";" " " FLAGS "${V_FLAGS}")
+  STRING(REPLACE ";" " " CFLAGS "${V_CFLAGS}")
+  SET(OUTPUTS ${VERILATED_LIB} ${VERILATED_OBJ}/V${ANSWER}.h)
+  SET(MODE "--sc")
+  SET(RUNTIME "")
+  IF(V_NATIVE)
+    SET(MODE "--cc")
+    SET(RUNTIME 1)
+  ENDIF()
+  IF(V_THREADS)
+    SET(FLAGS "${FLAGS} --threads ${V_THREADS}")
+    SET(RUNTIME 1)
+  ENDIF()
+  IF(V_SAVABLE)
+    SET(FLAGS "${FLAGS} --savable")
+    SET(RUNTIME 1)
+  ENDIF()
+  IF(V_COVERAGE)
+    SET(FLAGS "${FLAGS} --coverage-toggle")
+    SET(RUNTIME 1)
+  ENDIF()
+  SET(TRACE_THREADS "")
+  IF(V_TRACE)
+    SET(RUNTIME 1)
+    IF(FLAGS MATCHES "--trace-threads")
+      SET(TRACE_THREADS 1)
+    ENDIF()
+  ENDIF()
+  IF(RUNTIME)
+    LIST(APPEND OUTPUTS ${VERILATED_RT})
+  ENDIF()
+
+  VERILATE_MODEL(${ANSWER} ${CMAKE_CURRENT_SOURCE_DIR} ${VERILATED_OBJ}
+    "${CMAKE_CURRENT_BINARY_DIR}/verilator_flags${SUFFIX}.txt"
+    MODE ${MODE}
+    RUNTIME "${RUNTIME}"
+    FLAGS "${FLAGS}"
+    CFLAGS "${CFLAGS}"
+    OUTPUTS ${OUTPUTS}
+    DEPENDS ${V_DEPENDS}
+    COMMENT "Verilating ${ANSWER}${SUFFIX}"
+    )
+  ADD_CUSTOM_TARGET(verilate${SUFFIX} DEPENDS ${OUTPUTS})
+
+  IF(V_EXCLUDE_FROM_ALL)
+    ADD_EXECUTABLE(${TARGET} EXCLUDE_FROM_ALL ${SOURCE})
+  ELSE()
+    ADD_EXECUTABLE(${TARGET} ${SOURCE})
+  ENDIF()
+  ADD_DEPENDENCIES(${TARGET} verilate${SUFFIX})
+  TARGET_INCLUDE_DIRECTORIES(${TARGET} PUBLIC
     ${Verilator_INCLUDE_DIR}
     ${SystemC_INCLUDE_DIR}
     ${Libtb_INCLUDE_DIRS}
+    ${Libtbx_INCLUDE_DIRS}
     ${VERILATED_OBJ}
     )
-  TARGET_LINK_LIBRARIES(${ANSWER}
-    ${SystemC_LIBRARY}
-    ${VERILATED_LIB}
-    verilated
-    pthread
-    tb
+  IF(V_TRACE)
+    TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE VM_TRACE=1)
+  ELSE()
+    TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE VM_TRACE=0)
+  ENDIF()
+  IF(V_NATIVE)
+    TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE LIBTBX_BACKEND_NATIVE=1)
+  ENDIF()
+  IF(V_SAVABLE)
+    TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE
+      LIBTBX_SAVABLE=1
+      LIBTBX_VARIANT="${TARGET}")
+  ENDIF()
+  IF(V_COVERAGE)
+    TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE VM_COVERAGE=1)
+  ENDIF()
+  IF(V_COROUTINES)
+    SET_TARGET_PROPERTIES(${TARGET} PROPERTIES CXX_STANDARD 20)
+    IF(NOT V_NATIVE)
+      TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE
+        SC_CPLUSPLUS=${SYSTEMC_CPLUSPLUS})
+    ENDIF()
+  ENDIF()
+  IF(V_REPORT_LEVEL)
+    TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE
+      LIBTBX_REPORT_MIN_LEVEL=LIBTBX_LEVEL_${V_REPORT_LEVEL})
+  ENDIF()
+  IF(V_CFLAGS)
+    TARGET_COMPILE_OPTIONS(${TARGET} PRIVATE ${V_CFLAGS})
+  ENDIF()
+  IF(V_LINK_FLAGS)
+    STRING(REPLACE ";" " " LINK_FLAGS "${V_LINK_FLAGS}")
+    SET_TARGET_PROPERTIES(${TARGET} PROPERTIES LINK_FLAGS "${LINK_FLAGS}")
+  ENDIF()
+  IF(V_THREADS OR TRACE_THREADS)
+    TARGET_COMPILE_DEFINITIONS(${TARGET} PRIVATE VL_THREADED=1)
+  ENDIF()
+  IF(RUNTIME)
+    TARGET_LINK_LIBRARIES(${TARGET}
+      tbx
+      ${SystemC_LIBRARY}
+      ${VERILATED_LIB}
+      ${VERILATED_RT}
+      pthread
+      tb
+      )
+    IF(V_TRACE)
+      TARGET_LINK_LIBRARIES(${TARGET} z)
+    ENDIF()
+  ELSE()
+    TARGET_LINK_LIBRARIES(${TARGET}
+      tbx
+      ${SystemC_LIBRARY}
+      ${VERILATED_LIB}
+      verilated
+      pthread
+      tb
+      )
+  ENDIF()
+ENDFUNCTION()
+
+# Emit the simulation targets for ANSWER.
+#
+#   VERILATOR_THREADS N
+#            Verilate multithreaded models (--threads N).
+#   NATIVE   Emit <answer>_native, the fast model built upon the native
+#            backend of libtbx, which bypasses the SystemC kernel (SystemC is
+#            still linked for reporting). The testbench must be written
+#            against <libtbx/backend.h>.
+#   SAVABLE  Verilate savable models such that the testbench may checkpoint
+#            and restore its state (see <libtbx/checkpoint.h>). The
+#            multithreaded <answer>_t<N> benchmarks are not savable.
+#   COROUTINES
+#            The testbench runs processes as coroutines (see
+#            <libtbx/coro.h>), and is therefore built as C++20.
+#   SWEEP    Emit <answer>_sweep from <answer>_sweep.cpp: an exhaustive,
+#            multithreaded sweep of the input space of a combinational answer
+#            upon plain (--cc) models (see <libtbx/sweep.h>). The target
+#            'sweep' builds and runs all such sweeps.
+#   EXPLORE  Emit <answer>_explore from <answer>_explore.cpp: a breadth-first
+#            exploration of the reachable states of a sequential answer upon
+#            plain (--cc), savable models (see <libtbx/explore.h>). The target
+#            'explore' builds and runs all such explorations.
+#   ACTIVITY Emit <answer>_activity, the fast model instrumented to count the
+#            toggles of each signal (see <libtbx/activity.h>). The testbench
+#            must instantiate libtbx::Activity.
+#   ACTIVITY_BASELINE FLAGS...
+#            Emit <answer>_activity_baseline, verilated with the additional
+#            Verilator options FLAGS (typically, selecting an alternative
+#            implementation of the answer with --top-module and --prefix), and
+#            the target <answer>_activity_report comparing the switching
+#            activity of the baseline against that of the answer under the
+#            same test. The top-level target 'activity_report' runs all such
+#            comparisons.
+#   BENCH_THREADS
+#            Emit <answer>_t<N> for each N in BENCH_THREADS_COUNTS, and the
+#            target <answer>_bench_threads reporting the simulation rate of
+#            each. The top-level target 'bench_threads' runs all such
+#            benchmarks.
+#
+# When BUILD_PGO_MODELS is enabled, <answer>_pgo is emitted alongside the
+# instrumented <answer>_pgo_gen, and <answer>_pgo_report records the simulation
+# rate of <answer>_fast (before) and <answer>_pgo (after) in pgo_report.txt.
+#
+MACRO(EMIT_ANSWER ANSWER)
+  CMAKE_PARSE_ARGUMENTS(EMIT
+    "NATIVE;SAVABLE;COROUTINES;SWEEP;EXPLORE;ACTIVITY;BENCH_THREADS"
+    "VERILATOR_THREADS" "ACTIVITY_BASELINE" ${ARGN})
+
+  SET_PROPERTY(GLOBAL APPEND PROPERTY ANSWERS ${ANSWER})
+
+  SET(__savable "")
+  IF(EMIT_SAVABLE)
+    IF(EMIT_VERILATOR_THREADS)
+      MESSAGE(FATAL_ERROR "${ANSWER}: SAVABLE models cannot be multithreaded")
+    ENDIF()
+    SET(__savable SAVABLE)
+  ENDIF()
+  SET(__coroutines "")
+  IF(EMIT_COROUTINES)
+    SET(__coroutines COROUTINES)
+  ENDIF()
+
+  SEPARATE_ARGUMENTS(__debug_flags UNIX_COMMAND "${VERILATOR_DEBUG_FLAGS}")
+  SEPARATE_ARGUMENTS(__fast_flags UNIX_COMMAND "${VERILATOR_FAST_FLAGS}")
+  SEPARATE_ARGUMENTS(__fast_cflags UNIX_COMMAND "${VERILATOR_FAST_CFLAGS}")
+
+  EMIT_ANSWER_VARIANT(${ANSWER} ${ANSWER} ""
+    TRACE
+    ${__savable}
+    ${__coroutines}
+    REPORT_LEVEL ${REPORT_MIN_LEVEL}
+    FLAGS ${__debug_flags}
+    THREADS ${EMIT_VERILATOR_THREADS}
     )
+
+  # The fast model is the baseline against which the profile-guided model is
+  # measured; it is therefore emitted (but not built by default) whenever PGO
+  # is enabled.
+  #
+  IF(BUILD_FAST_MODELS)
+    EMIT_ANSWER_VARIANT(${ANSWER}_fast ${ANSWER} "_fast"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      ${__savable}
+      ${__coroutines}
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags}
+      THREADS ${EMIT_VERILATOR_THREADS}
+      )
+  ELSEIF(BUILD_PGO_MODELS)
+    EMIT_ANSWER_VARIANT(${ANSWER}_fast ${ANSWER} "_fast"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      ${__savable}
+      ${__coroutines}
+      EXCLUDE_FROM_ALL
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags}
+      THREADS ${EMIT_VERILATOR_THREADS}
+      )
+  ENDIF()
+
+  IF(EMIT_NATIVE)
+    EMIT_ANSWER_VARIANT(${ANSWER}_native ${ANSWER} "_native"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      NATIVE
+      ${__savable}
+      ${__coroutines}
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags}
+      )
+  ENDIF()
+
+  IF(EMIT_SWEEP)
+    EMIT_ANSWER_VARIANT(${ANSWER}_sweep ${ANSWER} "_sweep"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      NATIVE
+      EXCLUDE_FROM_ALL
+      SOURCE ${ANSWER}_sweep.cpp
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags}
+      )
+    SET_PROPERTY(GLOBAL APPEND PROPERTY SWEEP_TARGETS ${ANSWER}_sweep)
+  ENDIF()
+
+  IF(EMIT_EXPLORE)
+    EMIT_ANSWER_VARIANT(${ANSWER}_explore ${ANSWER} "_explore"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      NATIVE
+      SAVABLE
+      EXCLUDE_FROM_ALL
+      SOURCE ${ANSWER}_explore.cpp
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags}
+      )
+    SET_PROPERTY(GLOBAL APPEND PROPERTY EXPLORE_TARGETS ${ANSWER}_explore)
+  ENDIF()
+
+  IF(EMIT_ACTIVITY OR EMIT_ACTIVITY_BASELINE)
+    EMIT_ANSWER_VARIANT(${ANSWER}_activity ${ANSWER} "_activity"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      COVERAGE
+      ${__coroutines}
+      EXCLUDE_FROM_ALL
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags}
+      )
+  ENDIF()
+
+  IF(EMIT_ACTIVITY_BASELINE)
+    EMIT_ANSWER_VARIANT(${ANSWER}_activity_baseline ${ANSWER}
+      "_activity_baseline"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      COVERAGE
+      ${__coroutines}
+      EXCLUDE_FROM_ALL
+      FLAGS ${__fast_flags} ${EMIT_ACTIVITY_BASELINE}
+      CFLAGS ${__fast_cflags}
+      )
+
+    ADD_CUSTOM_TARGET(${ANSWER}_activity_report
+      COMMAND ${CMAKE_SOURCE_DIR}/scripts/bench_activity.sh
+         $<TARGET_FILE:${ANSWER}_activity_baseline>
+         $<TARGET_FILE:${ANSWER}_activity>
+         ${CMAKE_CURRENT_BINARY_DIR}/activity_report.txt
+      DEPENDS ${ANSWER}_activity_baseline ${ANSWER}_activity
+      COMMENT "Measuring the switching activity of ${ANSWER} against its baseline"
+      )
+    SET_PROPERTY(GLOBAL APPEND PROPERTY ACTIVITY_REPORT_TARGETS
+      ${ANSWER}_activity_report)
+  ENDIF()
+
+  IF(BUILD_PGO_MODELS)
+    SEPARATE_ARGUMENTS(__pgo_gen_flags UNIX_COMMAND "${PGO_GENERATE_FLAGS}")
+    SEPARATE_ARGUMENTS(__pgo_use_flags UNIX_COMMAND "${PGO_USE_FLAGS}")
+
+    EMIT_ANSWER_VARIANT(${ANSWER}_pgo_gen ${ANSWER} "_pgo_gen"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      ${__savable}
+      ${__coroutines}
+      EXCLUDE_FROM_ALL
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags} ${__pgo_gen_flags}
+      LINK_FLAGS ${__pgo_gen_flags}
+      THREADS ${EMIT_VERILATOR_THREADS}
+      )
+
+    # Train on the answer's own test. The resultant profiles, for both the
+    # model and the testbench, are moved to the object directories of the
+    # <answer>_pgo build, whose stale objects are discarded such that they are
+    # recompiled against the new profile.
+    #
+    SET(__pgo_stamp ${CMAKE_CURRENT_BINARY_DIR}/pgo_train.stamp)
+    ADD_CUSTOM_COMMAND(
+      OUTPUT ${__pgo_stamp}
+      COMMAND ${CMAKE_SOURCE_DIR}/scripts/pgo_train.sh
+         $<TARGET_FILE:${ANSWER}_pgo_gen>
+         ${__pgo_stamp}
+         ${CMAKE_CURRENT_BINARY_DIR}/obj_pgo_gen
+         ${CMAKE_CURRENT_BINARY_DIR}/obj_pgo
+         ${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${ANSWER}_pgo_gen.dir
+         ${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${ANSWER}_pgo.dir
+      DEPENDS
+         ${ANSWER}_pgo_gen
+         ${CMAKE_SOURCE_DIR}/scripts/pgo_train.sh
+      COMMENT "Training ${ANSWER}_pgo"
+      )
+
+    EMIT_ANSWER_VARIANT(${ANSWER}_pgo ${ANSWER} "_pgo"
+      REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+      ${__savable}
+      ${__coroutines}
+      FLAGS ${__fast_flags}
+      CFLAGS ${__fast_cflags} ${__pgo_use_flags}
+      THREADS ${EMIT_VERILATOR_THREADS}
+      DEPENDS ${__pgo_stamp}
+      )
+
+    ADD_CUSTOM_TARGET(${ANSWER}_pgo_report
+      COMMAND ${CMAKE_SOURCE_DIR}/scripts/bench_pgo.sh
+         $<TARGET_FILE:${ANSWER}_fast>
+         $<TARGET_FILE:${ANSWER}_pgo>
+         ${CMAKE_CURRENT_BINARY_DIR}/pgo_report.txt
+      DEPENDS ${ANSWER}_fast ${ANSWER}_pgo
+      COMMENT "Measuring ${ANSWER} before and after profile-guided optimization"
+      )
+    SET_PROPERTY(GLOBAL APPEND PROPERTY PGO_REPORT_TARGETS
+      ${ANSWER}_pgo_report)
+  ENDIF()
+
+  IF(EMIT_BENCH_THREADS)
+    SET(__bench_targets "")
+    FOREACH(__n ${BENCH_THREADS_COUNTS})
+      EMIT_ANSWER_VARIANT(${ANSWER}_t${__n} ${ANSWER} "_t${__n}"
+        REPORT_LEVEL ${FAST_REPORT_MIN_LEVEL}
+        ${__coroutines}
+        EXCLUDE_FROM_ALL
+        FLAGS ${__fast_flags}
+        CFLAGS ${__fast_cflags}
+        THREADS ${__n}
+        )
+      LIST(APPEND __bench_targets ${ANSWER}_t${__n})
+    ENDFOREACH()
+    SET(__bench_exes "")
+    FOREACH(__t ${__bench_targets})
+      LIST(APPEND __bench_exes $<TARGET_FILE:${__t}>)
+    ENDFOREACH()
+    ADD_CUSTOM_TARGET(${ANSWER}_bench_threads
+      COMMAND ${CMAKE_SOURCE_DIR}/scripts/bench_threads.sh ${__bench_exes}
+      DEPENDS ${__bench_targets}
+      COMMENT "Benchmarking ${ANSWER} across Verilator thread counts"
+      )
+    SET_PROPERTY(GLOBAL APPEND PROPERTY BENCH_THREADS_TARGETS
+      ${ANSWER}_bench_threads)
+  ENDIF()
 ENDMACRO()
+
+# Emit the differential (lockstep) testbench TARGET: for each N in
+# LOCKSTEP_SIZES, the executable ${TARGET}_n<N> from ${TARGET}.cpp, linked
+# against plain (--cc) fast models of each answer in MODELS. Each answer is
+# verilated from its own directory (a sibling of the current directory) with
+# its size parameter, the corresponding entry of PARAMS, set to N. The
+# testbench is built upon the native backend, with LOCKSTEP_N defined as N.
+# The target ${TARGET}_bench runs each size in turn, with profiling enabled.
+#
+FUNCTION(EMIT_LOCKSTEP TARGET)
+  CMAKE_PARSE_ARGUMENTS(L "" "" "MODELS;PARAMS" ${ARGN})
+
+  SEPARATE_ARGUMENTS(__fast_flags UNIX_COMMAND "${VERILATOR_FAST_FLAGS}")
+  SEPARATE_ARGUMENTS(__fast_cflags UNIX_COMMAND "${VERILATOR_FAST_CFLAGS}")
+  STRING(REPLACE ";" " " CFLAGS "${__fast_cflags}")
+
+  SET(__bench_targets "")
+  SET(__bench_commands "")
+  FOREACH(__n ${LOCKSTEP_SIZES})
+    SET(__exe ${TARGET}_n${__n})
+    SET(__outputs "")
+    SET(__objs "")
+    SET(__libs "")
+    SET(__i 0)
+    FOREACH(__model ${L_MODELS})
+      LIST(GET L_PARAMS ${__i} __param)
+      MATH(EXPR __i "${__i} + 1")
+
+      GET_FILENAME_COMPONENT(__dir ${CMAKE_CURRENT_SOURCE_DIR}/../${__model}
+        ABSOLUTE)
+      SET(__obj "${CMAKE_CURRENT_BINARY_DIR}/obj_${__model}_n${__n}")
+      SET(__model_outputs
+        ${__obj}/V${__model}__ALL.a
+        ${__obj}/V${__model}.h
+        ${__obj}/libverilated_rt.a)
+      VERILATE_MODEL(${__model} ${__dir} ${__obj}
+        "${CMAKE_CURRENT_BINARY_DIR}/verilator_flags_${__model}_n${__n}.txt"
+        MODE "--cc"
+        RUNTIME 1
+        FLAGS "${VERILATOR_FAST_FLAGS} -G${__param}=${__n}"
+        CFLAGS "${CFLAGS}"
+        OUTPUTS ${__model_outputs}
+        COMMENT "Verilating ${__model} (${__param}=${__n})"
+        )
+      LIST(APPEND __outputs ${__model_outputs})
+      LIST(APPEND __objs ${__obj})
+      LIST(APPEND __libs ${__obj}/V${__model}__ALL.a)
+    ENDFOREACH()
+    # The runtime of each model is identically configured; one suffices.
+    #
+    LIST(GET __objs 0 __obj)
+    LIST(APPEND __libs ${__obj}/libverilated_rt.a)
+
+    ADD_CUSTOM_TARGET(verilate_${__exe} DEPENDS ${__outputs})
+    ADD_EXECUTABLE(${__exe} ${TARGET}.cpp)
+    ADD_DEPENDENCIES(${__exe} verilate_${__exe})
+    TARGET_INCLUDE_DIRECTORIES(${__exe} PUBLIC
+      ${Verilator_INCLUDE_DIR}
+      ${SystemC_INCLUDE_DIR}
+      ${Libtb_INCLUDE_DIRS}
+      ${Libtbx_INCLUDE_DIRS}
+      ${__objs}
+      )
+    TARGET_COMPILE_DEFINITIONS(${__exe} PRIVATE
+      VM_TRACE=0
+      LIBTBX_BACKEND_NATIVE=1
+      LIBTBX_REPORT_MIN_LEVEL=LIBTBX_LEVEL_${FAST_REPORT_MIN_LEVEL}
+      LOCKSTEP_N=${__n}
+      )
+    TARGET_COMPILE_OPTIONS(${__exe} PRIVATE ${__fast_cflags})
+    TARGET_LINK_LIBRARIES(${__exe}
+      tbx
+      ${SystemC_LIBRARY}
+      ${__libs}
+      pthread
+      tb
+      )
+    LIST(APPEND __bench_targets ${__exe})
+    LIST(APPEND __bench_commands COMMAND $<TARGET_FILE:${__exe}> +profile=1)
+  ENDFOREACH()
+
+  ADD_CUSTOM_TARGET(${TARGET}_bench ${__bench_commands}
+    DEPENDS ${__bench_targets}
+    COMMENT "Running ${TARGET} across LOCKSTEP_SIZES"
+    )
+ENDFUNCTION()
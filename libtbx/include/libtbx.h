@@ -0,0 +1,52 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_H
+#define LIBTBX_H
+
+#include <libtbx/activity.h>
+#include <libtbx/backend.h>
+#include <libtbx/bitvector.h>
+#include <libtbx/checkpoint.h>
+#include <libtbx/coro.h>
+#include <libtbx/coverage.h>
+#include <libtbx/edges.h>
+#include <libtbx/explore.h>
+#include <libtbx/knob.h>
+#include <libtbx/model_pipeline.h>
+#include <libtbx/profile.h>
+#include <libtbx/random.h>
+#include <libtbx/report.h>
+#include <libtbx/scoreboard.h>
+#include <libtbx/sim.h>
+#include <libtbx/sweep.h>
+#include <libtbx/testlist.h>
+#include <libtbx/trace.h>
+#include <libtbx/txlog.h>
+#include <libtbx/wave.h>
+
+#endif
@@ -0,0 +1,107 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_ACTIVITY_H
+#define LIBTBX_ACTIVITY_H
+
+#include <cstddef>
+#include <string>
+
+#if VM_COVERAGE
+#  include <libtbx/sim.h>
+#  include <verilated_cov.h>
+#  include <unistd.h>
+#  include <cstdio>
+#endif
+
+// Switching activity of a verilated model. The <answer>_activity model of an
+// answer emitted with ACTIVITY (see cmake/Macros.cmake) is verilated with
+// toggle coverage (--coverage-toggle), such that every change of each bit of
+// each signal is counted by the model itself as it is evaluated. Upon
+// completion of the simulation, the counts are summarized on lines prefixed by
+// "[libtbx] activity": the total number of toggles per simulated cycle, then
+// the knob 'activity_top' most active signals. The knob 'saif' additionally
+// exports the per-bit counts to the named SAIF file for power analysis:
+//
+//   ./fifo_sr_activity +saif=fifo_sr.saif
+//
+// The testbench instantiates an Activity alongside its model:
+//
+//   libtbx::Activity activity_;
+//
+// Only toggle counts (TC) are recorded; the time spent at each value (T0, T1)
+// is not. Each cycle is written as 1ns.
+//
+namespace libtbx {
+
+struct ActivityOptions {
+  std::string saif;
+  std::size_t top;
+};
+
+const ActivityOptions & activity_options();
+
+// Summarize the toggle counts of the coverage database FILE (as written by
+// VerilatedCov) over CYCLES simulated cycles and, when requested, export them
+// as SAIF.
+//
+void report_activity(const std::string & file, double cycles);
+
+// Report that activity was requested of a model which is not instrumented.
+//
+void activity_unavailable();
+
+#if VM_COVERAGE
+
+class Activity {
+ public:
+  Activity() {
+    on_complete([](double cycles) {
+        const std::string file =
+            "activity." + std::to_string(::getpid()) + ".dat";
+        VerilatedCov::write(file.c_str());
+        report_activity(file, cycles);
+        std::remove(file.c_str());
+      });
+  }
+};
+
+#else
+
+class Activity {
+ public:
+  Activity() {
+    if (!activity_options().saif.empty())
+      activity_unavailable();
+  }
+};
+
+#endif
+
+} // namespace libtbx
+
+#endif
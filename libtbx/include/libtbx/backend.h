@@ -0,0 +1,96 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_BACKEND_H
+#define LIBTBX_BACKEND_H
+
+#include <libtb.h>
+
+// Backend selection. Testbenches written against the definitions below may be
+// built either upon the SystemC kernel (the default) or, when compiled with
+// LIBTBX_BACKEND_NATIVE, upon the native backend (see <libtbx/native.h>)
+// without further change.
+//
+//   LIBTBX_HAS_PROCESS(T)     In place of SC_HAS_PROCESS(T).
+//   LIBTBX_THREAD(f)          In place of SC_THREAD(f).
+//   LIBTBX_SAMPLE(f)          Invoke method f upon each e_tb_sample().
+//   LIBTBX_BIND_UUT(uut)      Bind the clock and reset of the model.
+//   LIBTBX_BIND_PORT(uut, p)  Bind port p of the model to signal p_.
+//
+#if LIBTBX_BACKEND_NATIVE
+
+#include <libtbx/native.h>
+
+namespace libtbx {
+
+using TopLevel = native::TopLevel;
+using ModuleName = const char *;
+using Event = native::Event;
+template <typename T>
+using Signal = native::Signal<T>;
+
+} // namespace libtbx
+
+#define LIBTBX_HAS_PROCESS(__type)
+#define LIBTBX_THREAD(__func)                   \
+  spawn([this]() { __func(); })
+#define LIBTBX_SAMPLE(__func)                   \
+  on_sample([this]() { __func(); })
+#define LIBTBX_BIND_UUT(__uut)                  \
+  bind_uut(__uut)
+#define LIBTBX_BIND_PORT(__uut, __name)         \
+  __name##_.bind(__uut.__name)
+
+#else
+
+namespace libtbx {
+
+using TopLevel = libtb::TopLevel;
+using ModuleName = sc_core::sc_module_name;
+using Event = sc_core::sc_event;
+template <typename T>
+using Signal = sc_core::sc_signal<T>;
+
+} // namespace libtbx
+
+#define LIBTBX_HAS_PROCESS(__type)              \
+  SC_HAS_PROCESS(__type)
+#define LIBTBX_THREAD(__func)                   \
+  SC_THREAD(__func)
+#define LIBTBX_SAMPLE(__func)                   \
+  SC_METHOD(__func);                            \
+  dont_initialize();                            \
+  sensitive << e_tb_sample()
+#define LIBTBX_BIND_UUT(__uut)                  \
+  __uut.clk(clk());                             \
+  __uut.rst(rst())
+#define LIBTBX_BIND_PORT(__uut, __name)         \
+  __uut.__name(__name##_)
+
+#endif
+
+#endif
@@ -0,0 +1,117 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_BITVECTOR_H
+#define LIBTBX_BITVECTOR_H
+
+#include <libtbx/random.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Random bit vectors of controlled population, for answers which operate upon
+// the set (or clear) bits of a vector. A vector of W bits, of any width, is
+// held in bit_words(W) 64-bit words, least significant first; bits of the
+// last word above W are clear. Neither generator rejects and retries:
+//
+//   random_bits_count    Exactly K bits set, chosen uniformly, in
+//                        O(words + min(K, W - K)) time (Floyd's algorithm
+//                        upon the sparser of the set and clear bits).
+//   random_bits_density  Each bit set with probability P, in O(words).
+//   corner_count         A count chosen uniformly from 0, 1, 2, W - 1 and W,
+//                        the populations at which such logic usually fails.
+//
+// Variants upon a single integral word of up to 64 bits are provided.
+//
+namespace libtbx {
+
+constexpr std::size_t bit_words(std::size_t w) { return (w + 63) / 64; }
+
+namespace detail {
+
+inline void mask_bits(std::uint64_t * v, std::size_t w) {
+  if (w % 64 != 0)
+    v[w / 64] &= (std::uint64_t{1} << (w % 64)) - 1;
+}
+
+} // namespace detail
+
+inline void random_bits_count(Rng & rng, std::uint64_t * v, std::size_t w,
+                              std::size_t k) {
+  if (k > w)
+    k = w;
+  const bool invert = (k > w / 2);
+  const std::size_t m = invert ? (w - k) : k;
+  for (std::size_t i = 0; i < bit_words(w); i++)
+    v[i] = 0;
+  for (std::size_t j = w - m; j < w; j++) {
+    const std::size_t t = rng.bounded(j + 1);
+    const std::size_t b = (v[t / 64] & (std::uint64_t{1} << (t % 64))) ? j : t;
+    v[b / 64] |= std::uint64_t{1} << (b % 64);
+  }
+  if (invert) {
+    for (std::size_t i = 0; i < bit_words(w); i++)
+      v[i] = ~v[i];
+    detail::mask_bits(v, w);
+  }
+}
+
+inline void random_bits_density(Rng & rng, std::uint64_t * v, std::size_t w,
+                                double p) {
+  rng.fill_bernoulli(v, bit_words(w), p);
+  detail::mask_bits(v, w);
+}
+
+inline std::size_t corner_count(Rng & rng, std::size_t w) {
+  const std::size_t corners[] = {0, 1, 2, w - 1, w};
+  const std::size_t k = corners[rng.bounded(5)];
+  return (k > w) ? w : k;
+}
+
+template <typename T>
+T random_bits_count(Rng & rng, std::size_t k,
+                    std::size_t w = std::numeric_limits<T>::digits) {
+  static_assert(std::numeric_limits<T>::digits <= 64,
+                "use the multi-word form for vectors wider than 64 bits");
+  std::uint64_t v;
+  random_bits_count(rng, &v, w, k);
+  return static_cast<T>(v);
+}
+
+template <typename T>
+T random_bits_density(Rng & rng, double p,
+                      std::size_t w = std::numeric_limits<T>::digits) {
+  static_assert(std::numeric_limits<T>::digits <= 64,
+                "use the multi-word form for vectors wider than 64 bits");
+  std::uint64_t v;
+  random_bits_density(rng, &v, w, p);
+  return static_cast<T>(v);
+}
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,169 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_CHECKPOINT_H
+#define LIBTBX_CHECKPOINT_H
+
+#include <libtb.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#if LIBTBX_SAVABLE
+#  include <verilated_save.h>
+#endif
+
+// Tag of the model variant (the name of the target), written to each
+// checkpoint; defined by EMIT_ANSWER_VARIANT for savable models.
+//
+#ifndef LIBTBX_VARIANT
+#  define LIBTBX_VARIANT ""
+#endif
+
+// Checkpoint and restore of a verilated model (verilated with --savable; see
+// EMIT_ANSWER SAVABLE) alongside arbitrary testbench state. A checkpoint is
+// written to the file named by LIBTBX_SAVE and read from the file named by
+// LIBTBX_RESTORE. Testbench state is written to a SaveStream and read from a
+// RestoreStream using operator<< and operator>> upon fundamental types.
+//
+// In models which are not savable, both paths are reported as unset such that
+// testbenches need not be conditionally compiled.
+//
+// A checkpoint may be restored only into the model variant by which it was
+// written, and with the same configuration. Each checkpoint therefore begins
+// with the variant tag and a configuration string supplied by the testbench
+// (for example, the values of the knobs which determine the checkpointed
+// state); a restore upon which either differs is fatal.
+//
+namespace libtbx {
+
+#if LIBTBX_SAVABLE
+
+using SaveStream = VerilatedSerialize;
+using RestoreStream = VerilatedDeserialize;
+
+#else
+
+struct SaveStream {
+  template <typename T> SaveStream & operator<<(T &) { return *this; }
+};
+
+struct RestoreStream {
+  template <typename T> RestoreStream & operator>>(T &) { return *this; }
+};
+
+#endif
+
+class Checkpoint {
+ public:
+  static const char * save_path() { return path("LIBTBX_SAVE"); }
+  static const char * restore_path() { return path("LIBTBX_RESTORE"); }
+
+  // Write CONFIG, the state of model M and, through F(SaveStream &), the
+  // state of the testbench to FN.
+  //
+  template <typename M, typename F>
+  static void save(const char * fn, const std::string & config, M & m, F f) {
+#if LIBTBX_SAVABLE
+    VerilatedSave os;
+    os.open(fn);
+    write_string(os, LIBTBX_VARIANT);
+    write_string(os, config);
+    os << m;
+    f(os);
+    os.close();
+#endif
+  }
+
+  // Read the state of model M and, through F(RestoreStream &), the state of
+  // the testbench from FN, having checked that it was written by this variant
+  // with configuration CONFIG.
+  //
+  template <typename M, typename F>
+  static void restore(const char * fn, const std::string & config, M & m,
+                      F f) {
+#if LIBTBX_SAVABLE
+    VerilatedRestore is;
+    is.open(fn);
+    std::string variant, written;
+    if (!read_string(is, variant) || !read_string(is, written)) {
+      LIBTB_REPORT_FATAL(std::string{fn} + ": not a checkpoint");
+      return;
+    }
+    if ((variant != LIBTBX_VARIANT) || (written != config)) {
+      std::stringstream ss;
+      ss << fn << ": checkpoint of " << variant << " (" << written
+         << ") cannot be restored by " << LIBTBX_VARIANT << " (" << config
+         << ")";
+      LIBTB_REPORT_FATAL(ss.str());
+      return;
+    }
+    is >> m;
+    f(is);
+    is.close();
+#endif
+  }
+
+ private:
+#if LIBTBX_SAVABLE
+  // Strings are written as their length followed by their characters.
+  //
+  static const std::uint32_t STRING_MAX = 4096;
+
+  static void write_string(SaveStream & os, const std::string & s) {
+    std::uint32_t n = static_cast<std::uint32_t>(s.size());
+    os << n;
+    os.write(s.data(), n);
+  }
+
+  static bool read_string(RestoreStream & is, std::string & s) {
+    std::uint32_t n = 0;
+    is >> n;
+    if (n > STRING_MAX)
+      return false;
+    s.resize(n);
+    is.read(&s[0], n);
+    return true;
+  }
+#endif
+
+  static const char * path(const char * var) {
+#if LIBTBX_SAVABLE
+    const char * fn = std::getenv(var);
+    return (fn != nullptr && *fn != '\0') ? fn : nullptr;
+#else
+    (void)var;
+    return nullptr;
+#endif
+  }
+};
+
+} // namespace libtbx
+
+#endif
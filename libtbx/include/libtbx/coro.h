@@ -0,0 +1,333 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_CORO_H
+#define LIBTBX_CORO_H
+
+#include <libtbx/backend.h>
+
+// Coroutine processes. Stimulus is conventionally written as threads which
+// block upon t_wait_posedge_clk() once per transaction, each call incurring a
+// full context switch. A process may instead be written as a C++20 coroutine
+// (libtbx::Task) which suspends by way of co_await upon the awaitables of a
+// libtbx::CoScheduler:
+//
+//   co_await co_.posedge(n)     In place of t_wait_posedge_clk(n).
+//   co_await co_.sync()         In place of t_wait_sync().
+//   co_await co_.reset_done()   In place of t_wait_reset_done().
+//   co_await co_.rising(f)      Until f() is first found to become true at the
+//                               sample point; in place of waiting upon the
+//                               posedge_event() of a signal.
+//   co_await b_task(...)        Invoke a nested Task to completion.
+//
+// Suspended coroutines are resumed inline from the clock: once per posedge
+// and once per sample point. Under SystemC, this requires only two methods
+// for all coroutines of the scheduler; under the native backend, the cycle
+// loop resumes them directly. The sequential style of the stimulus is
+// retained but no stack is switched.
+//
+// Coroutines are resumed in order of suspension. Like threads, coroutines
+// must not suspend within a LIBTBX_PROFILE_SCOPE. The facility is available
+// only to testbenches compiled as C++20 (see COROUTINES in
+// cmake/Macros.cmake), in which case LIBTBX_HAS_COROUTINES is defined.
+//
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#define LIBTBX_HAS_COROUTINES 1
+
+namespace libtbx {
+
+class Task {
+ public:
+  struct promise_type {
+    Task get_return_object() {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    // Tasks are lazily started: by the scheduler, or by the Task awaiting
+    // them.
+    //
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // Upon completion, control is transferred directly to the awaiting Task
+    // (if any).
+    //
+    struct FinalAwaiter {
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<promise_type> h) noexcept {
+        if (std::coroutine_handle<> c = h.promise().continuation)
+          return c;
+        return std::noop_coroutine();
+      }
+      void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void return_void() {}
+    void unhandled_exception() { exception = std::current_exception(); }
+
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+  };
+
+  Task(Task && t) noexcept : h_(std::exchange(t.h_, nullptr)) {}
+  Task & operator=(Task && t) noexcept {
+    std::swap(h_, t.h_);
+    return *this;
+  }
+  ~Task() {
+    if (h_)
+      h_.destroy();
+  }
+
+  bool done() const { return !h_ || h_.done(); }
+
+  // Rethrow any exception raised by a completed Task.
+  //
+  void rethrow() const {
+    if (h_ && h_.promise().exception)
+      std::rethrow_exception(h_.promise().exception);
+  }
+
+  // Awaiting a Task runs it, upon the same resumption, until it first
+  // suspends; the awaiting Task is resumed upon its completion.
+  //
+  bool await_ready() const noexcept { return done(); }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept {
+    h_.promise().continuation = c;
+    return h_;
+  }
+  void await_resume() const { rethrow(); }
+
+ private:
+  friend class CoScheduler;
+
+  explicit Task(std::coroutine_handle<promise_type> h) : h_(h) {}
+
+  std::coroutine_handle<promise_type> h_;
+};
+
+class CoScheduler {
+  struct Waiter {
+    std::coroutine_handle<> h;
+    std::uint64_t wake;
+  };
+
+  struct Condition {
+    std::coroutine_handle<> h;
+    std::function<bool()> f;
+    bool last;
+  };
+
+ public:
+  // Bind to the clock, reset and sample point of TOP. Constructed as a member
+  // of the testbench.
+  //
+  explicit CoScheduler(TopLevel & top);
+
+  CoScheduler(const CoScheduler &) = delete;
+  CoScheduler & operator=(const CoScheduler &) = delete;
+
+  // Launch T, which first runs at the first posedge of the clock.
+  //
+  void spawn(Task t) {
+    posedge_.push_back(Waiter{t.h_, cycle_ + 1});
+    tasks_.push_back(std::move(t));
+  }
+
+  // Number of posedges observed.
+  //
+  std::uint64_t cycle() const { return cycle_; }
+
+  struct PosedgeAwaiter {
+    CoScheduler & s;
+    std::uint64_t n;
+    bool await_ready() const noexcept { return n == 0; }
+    void await_suspend(std::coroutine_handle<> h) {
+      s.posedge_.push_back(Waiter{h, s.cycle_ + n});
+    }
+    void await_resume() const noexcept {}
+  };
+  PosedgeAwaiter posedge(int n = 1) {
+    return PosedgeAwaiter{*this, static_cast<std::uint64_t>(n)};
+  }
+
+  struct SyncAwaiter {
+    CoScheduler & s;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) { s.sync_.push_back(h); }
+    void await_resume() const noexcept {}
+  };
+  SyncAwaiter sync() { return SyncAwaiter{*this}; }
+
+  struct ResetAwaiter {
+    CoScheduler & s;
+    bool await_ready() const { return !s.in_reset_(); }
+    void await_suspend(std::coroutine_handle<> h) { s.reset_.push_back(h); }
+    void await_resume() const noexcept {}
+  };
+  ResetAwaiter reset_done() { return ResetAwaiter{*this}; }
+
+  struct RisingAwaiter {
+    CoScheduler & s;
+    std::function<bool()> f;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+      s.rising_.push_back(Condition{h, std::move(f), false});
+      s.rising_.back().last = s.rising_.back().f();
+    }
+    void await_resume() const noexcept {}
+  };
+  template <typename F>
+  RisingAwaiter rising(F f) { return RisingAwaiter{*this, std::move(f)}; }
+
+ private:
+  void on_posedge() {
+    ++cycle_;
+    if (!reset_.empty() && !in_reset_()) {
+      std::vector<std::coroutine_handle<> > due;
+      due.swap(reset_);
+      for (std::coroutine_handle<> h : due)
+        h.resume();
+    }
+    if (!posedge_.empty()) {
+      std::vector<Waiter> ws;
+      ws.swap(posedge_);
+      for (const Waiter & w : ws) {
+        if (w.wake <= cycle_)
+          w.h.resume();
+        else
+          posedge_.push_back(w);
+      }
+    }
+    reap();
+  }
+
+  void on_sync() {
+    if (!sync_.empty()) {
+      std::vector<std::coroutine_handle<> > due;
+      due.swap(sync_);
+      for (std::coroutine_handle<> h : due)
+        h.resume();
+    }
+    if (!rising_.empty()) {
+      std::vector<Condition> cs;
+      cs.swap(rising_);
+      for (Condition & c : cs) {
+        const bool now = c.f();
+        const bool fire = now && !c.last;
+        c.last = now;
+        if (fire)
+          c.h.resume();
+        else
+          rising_.push_back(std::move(c));
+      }
+    }
+    reap();
+  }
+
+  // Discard completed Tasks, propagating any exception they raised to the
+  // simulation kernel.
+  //
+  void reap() {
+    for (std::size_t i = 0; i < tasks_.size();) {
+      if (tasks_[i].done()) {
+        const Task t = std::move(tasks_[i]);
+        tasks_.erase(tasks_.begin() + i);
+        t.rethrow();
+      } else {
+        ++i;
+      }
+    }
+  }
+
+#if !LIBTBX_BACKEND_NATIVE
+  struct Driver : sc_core::sc_module {
+    SC_HAS_PROCESS(Driver);
+    Driver(sc_core::sc_module_name mn, CoScheduler & s,
+           const sc_core::sc_event & posedge, const sc_core::sc_event & sync)
+        : sc_core::sc_module(mn), s_(s) {
+      SC_METHOD(m_posedge);
+      dont_initialize();
+      sensitive << posedge;
+
+      SC_METHOD(m_sync);
+      dont_initialize();
+      sensitive << sync;
+    }
+
+    void m_posedge() { s_.on_posedge(); }
+    void m_sync() { s_.on_sync(); }
+
+    CoScheduler & s_;
+  };
+
+  std::unique_ptr<Driver> driver_;
+#endif
+
+  std::function<bool()> in_reset_;
+  std::uint64_t cycle_{0};
+  std::vector<Task> tasks_;
+  std::vector<Waiter> posedge_;
+  std::vector<std::coroutine_handle<> > sync_;
+  std::vector<std::coroutine_handle<> > reset_;
+  std::vector<Condition> rising_;
+};
+
+#if LIBTBX_BACKEND_NATIVE
+
+inline CoScheduler::CoScheduler(TopLevel & top) {
+  in_reset_ = [&top]() { return !top.is_reset_done(); };
+  top.on_posedge([this]() { on_posedge(); });
+  top.on_sample([this]() { on_sync(); });
+}
+
+#else
+
+inline CoScheduler::CoScheduler(TopLevel & top) {
+  const sc_core::sc_signal<bool> & rst = top.rst();
+  in_reset_ = [&rst]() { return rst.read(); };
+  driver_.reset(new Driver("co", *this, top.clk().posedge_event(),
+                           top.e_tb_sample()));
+}
+
+#endif
+
+} // namespace libtbx
+
+#endif
+
+#endif
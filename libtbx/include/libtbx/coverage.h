@@ -0,0 +1,147 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_COVERAGE_H
+#define LIBTBX_COVERAGE_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// Functional coverage. A Coverpoint counts samples into a fixed set of named
+// bins; a Cross counts samples into the product of the bins of two or more
+// coverpoints. Counters are flat arrays allocated upon construction, such that
+// sampling is an index computation and an increment:
+//
+//   libtbx::Coverpoint cp_op_{"op", {"INIT", "INC", "DEC", "QRY"}};
+//   libtbx::Coverpoint cp_same_id_{"same_id", {"no", "yes"}};
+//   libtbx::Cross cx_op_same_id_{"op_x_same_id", {&cp_op_, &cp_same_id_}};
+//   ...
+//   cx_op_same_id_.sample(op, same_id);
+//
+// Sampling a cross also samples each of its coverpoints, which therefore
+// count the marginals of all crosses in which they appear.
+//
+// A bin is covered once sampled GOAL times. Coverage is reported upon
+// completion of the simulation (see report_coverage()), with up to the knob
+// 'coverage_holes' uncovered bins of each coverpoint and cross.
+//
+// Random tests may run until all goals are met rather than for a fixed number
+// of transactions: coverage_done() returns true once every coverpoint and cross
+// is closed, should the knob 'coverage_stop' be set. The transaction count of
+// the test then becomes an upper bound.
+//
+namespace libtbx {
+
+class Coverage {
+ public:
+  Coverage(const char * name, std::size_t bins, std::uint64_t goal);
+  virtual ~Coverage();
+
+  const std::string & name() const { return name_; }
+  std::size_t bins() const { return counts_.size(); }
+  std::size_t covered() const { return covered_; }
+  std::uint64_t goal() const { return goal_; }
+  std::uint64_t samples() const { return samples_; }
+  std::uint64_t count(std::size_t bin) const { return counts_[bin]; }
+  bool closed() const { return covered_ == counts_.size(); }
+
+  // Rendering of BIN for the purpose of reporting.
+  //
+  virtual std::string bin_name(std::size_t bin) const = 0;
+
+ protected:
+  void hit(std::size_t bin) {
+    ++samples_;
+    if (++counts_[bin] == goal_)
+      cover();
+  }
+
+ private:
+  void cover();
+
+  std::string name_;
+  std::uint64_t goal_;
+  std::vector<std::uint64_t> counts_;
+  std::size_t covered_{0};
+  std::uint64_t samples_{0};
+};
+
+class Coverpoint : public Coverage {
+ public:
+  Coverpoint(const char * name, std::vector<std::string> bins,
+             std::uint64_t goal = 1);
+
+  // Sample BIN, an index into the bins of the coverpoint (unchecked).
+  //
+  void sample(std::size_t bin) { hit(bin); }
+
+  std::string bin_name(std::size_t bin) const override { return bins_[bin]; }
+
+ private:
+  std::vector<std::string> bins_;
+};
+
+class Cross : public Coverage {
+ public:
+  Cross(const char * name, std::initializer_list<Coverpoint *> points,
+        std::uint64_t goal = 1);
+
+  // Sample the product of BINS, one index per crossed coverpoint, in the order
+  // given upon construction (unchecked).
+  //
+  template <typename... Bins>
+  void sample(Bins... bins) { hit(index(0, bins...)); }
+
+  std::string bin_name(std::size_t bin) const override;
+
+ private:
+  std::size_t index(std::size_t) { return 0; }
+
+  template <typename... Bins>
+  std::size_t index(std::size_t i, std::size_t bin, Bins... bins) {
+    points_[i]->sample(bin);
+    return bin * strides_[i] + index(i + 1, bins...);
+  }
+
+  std::vector<Coverpoint *> points_;
+  std::vector<std::size_t> strides_;
+};
+
+// Whether all coverpoints and crosses are closed, and the knob 'coverage_stop'
+// is set.
+//
+bool coverage_done();
+
+// Report each live coverpoint and cross, and the total.
+//
+void report_coverage();
+
+} // namespace libtbx
+
+#endif
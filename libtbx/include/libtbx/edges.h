@@ -0,0 +1,177 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_EDGES_H
+#define LIBTBX_EDGES_H
+
+#include <libtb.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if !LIBTBX_BACKEND_NATIVE
+#  include <libtbx/sim.h>
+#endif
+
+// Self-checking of generated clocks. An EdgeMonitor records the time of each
+// rising and falling edge of a signal and, as each edge arrives, checks the
+// period and high time of the waveform against a ClockSpec; no waveform need
+// be written and post-processed. For a clock divided by 3, with a 50% duty
+// cycle:
+//
+//   libtbx::EdgeMonitor mon_{"mon_clk_div_3", libtbx::ClockSpec{3, 0.5}};
+//   ...
+//   mon_.in(clk_div_3_);
+//
+// Times are measured in cycles of the design clock, such that the same
+// specification applies to any odd (or even) divisor N as ClockSpec{N, 0.5}.
+// The first violation is reported as an error together with the edges which
+// preceded it, retained in a ring of the knob 'edges_depth' edges. Upon
+// completion of the simulation, each monitor reports a summary line prefixed
+// by "[libtbx] edges=": the number of edges recorded and periods checked, the
+// mean, minimum and maximum period and duty cycle, the peak-to-peak and RMS
+// period jitter and the maximum cycle-to-cycle jitter.
+//
+namespace libtbx {
+
+struct ClockSpec {
+  ClockSpec(double period, double duty = 0.5, double tolerance = 0,
+            std::size_t settle = 2)
+      : period(period), duty(duty), tolerance(tolerance), settle(settle) {}
+
+  // Expected period, in cycles of the design clock.
+  double period;
+  // Expected duty cycle: the fraction of each period for which the signal is
+  // high.
+  double duty;
+  // Permitted deviation of each period and high time, in cycles of the design
+  // clock.
+  double tolerance;
+  // Number of initial periods excluded from checks and statistics, during
+  // which the generated clock may settle after reset.
+  std::size_t settle;
+};
+
+// Backend-independent recorder of the edges of one signal. Times are in ticks
+// of the simulation kernel, of which TICKS_PER_CYCLE comprise a cycle of the
+// design clock.
+//
+class EdgeRecorder {
+ public:
+  EdgeRecorder(const std::string & name, const ClockSpec & spec);
+  ~EdgeRecorder();
+
+  // Record an edge, to LEVEL, at time T (in ticks).
+  //
+  void edge(std::uint64_t t, bool level);
+
+  void set_ticks_per_cycle(std::uint64_t ticks) { ticks_per_cycle_ = ticks; }
+
+  const std::string & name() const { return name_; }
+  std::uint64_t periods() const { return n_; }
+  std::uint64_t violations() const { return violations_; }
+
+  // Report an error should fewer than N periods have been checked; for example,
+  // should the generated clock have stopped.
+  //
+  void expect_periods(std::uint64_t n) const;
+
+  // Emit the summary line.
+  //
+  void report() const;
+
+ private:
+  void check(std::uint64_t period, std::uint64_t high);
+  void violation(const std::string & what);
+  double cycles(double ticks) const { return ticks / ticks_per_cycle_; }
+
+  std::string name_;
+  ClockSpec spec_;
+  std::uint64_t ticks_per_cycle_{1};
+
+  // Ring of the most recent edges: the time of each, shifted left by one, with
+  // the level in the least significant bit.
+  std::vector<std::uint64_t> ring_;
+  std::size_t head_{0};
+  std::uint64_t edges_{0};
+
+  // Time of the last rising and falling edge, once seen.
+  bool rose_{false};
+  bool fell_{false};
+  std::uint64_t rise_{0};
+  std::uint64_t fall_{0};
+  std::uint64_t last_period_{0};
+  std::size_t settled_{0};
+
+  // Online statistics of each checked period (Welford), the high time and the
+  // duty cycle, in ticks.
+  std::uint64_t n_{0};
+  double period_mean_{0};
+  double period_m2_{0};
+  std::uint64_t period_min_{0};
+  std::uint64_t period_max_{0};
+  double duty_mean_{0};
+  double duty_min_{0};
+  double duty_max_{0};
+  std::uint64_t c2c_max_{0};
+  std::uint64_t violations_{0};
+};
+
+#if !LIBTBX_BACKEND_NATIVE
+
+class EdgeMonitor : public sc_core::sc_module {
+ public:
+  sc_core::sc_in<bool> in;
+
+  SC_HAS_PROCESS(EdgeMonitor);
+  EdgeMonitor(sc_core::sc_module_name mn, const ClockSpec & spec)
+      : sc_module(mn), in("in"), recorder_(basename(), spec) {
+    SC_METHOD(m_edge);
+    sensitive << in;
+    dont_initialize();
+  }
+
+  const EdgeRecorder & recorder() const { return recorder_; }
+
+ private:
+  void start_of_simulation() override {
+    if (const sc_core::sc_clock * clk = design_clock())
+      recorder_.set_ticks_per_cycle(clk->period().value());
+  }
+
+  void m_edge() {
+    recorder_.edge(sc_core::sc_time_stamp().value(), in.read());
+  }
+
+  EdgeRecorder recorder_;
+};
+
+#endif
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,277 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_EXPLORE_H
+#define LIBTBX_EXPLORE_H
+
+#include <libtbx/knob.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if LIBTBX_SAVABLE
+#  include <verilated_save.h>
+#endif
+
+// Breadth-first exploration of the reachable state space of a sequential
+// answer. Rather than simulate random input sequences from reset, the state of
+// a plain (--cc), savable model is snapshot in memory after each transition,
+// such that every successor of a state is explored by restoring the snapshot
+// and applying one input choice, without re-simulating the path by which the
+// state was reached:
+//
+//   int sc_main(int argc, char ** argv) {
+//     return libtbx::explore<Vvending_machine_fsm, Reference>(
+//       argc, argv, {"idle", "nickel", "dime"},
+//       [](Vvending_machine_fsm & uut) { ... },
+//       [](Vvending_machine_fsm & uut, Reference & ref, std::size_t choice) {
+//         ...
+//         return std::string{};
+//       },
+//       [](Vvending_machine_fsm & uut) { ... });
+//   }
+//
+// RESET drives the model into its initial state. STEP applies CHOICE to the
+// model for one cycle, advances the C++ reference model REF accordingly, and
+// returns a description of the first violated invariant, or the empty string.
+// IDLE drives every input of the model, including the clock, to its idle value
+// before each snapshot, such that the inputs of the last cycle do not split
+// one state of the design into several. The reference is copied alongside
+// each snapshot, and provides:
+//
+//   bool allows(std::size_t choice) const;  // CHOICE is permitted next
+//   std::uint64_t key() const;              // Encoding of the reference state
+//
+// Two states are the same when both their serialized models and the keys of
+// their references are equal; a hash of the two only selects the candidates
+// to compare. Upon a violation, the sequence of choices from reset
+// is reported as a counterexample, on lines prefixed by "[libtbx] explore".
+// Exploration is bounded by the knobs 'explore_depth' and 'explore_states';
+// the summary reports complete=1 should every reachable state have been
+// explored within those bounds.
+//
+// Answers opt in by passing EXPLORE to EMIT_ANSWER, which emits
+// <answer>_explore from <answer>_explore.cpp.
+//
+namespace libtbx {
+
+struct ExploreOptions {
+  std::size_t depth;
+  std::size_t states;
+};
+
+const ExploreOptions & explore_options();
+
+// Report the counterexample WHY, reached by the sequence of choices PATH (as
+// indices into CHOICES), if any, then the summary. Returns non-zero should an
+// invariant have been violated.
+//
+int report_explore(const std::string & why, const std::vector<std::size_t> & path,
+                   const std::vector<std::string> & choices,
+                   std::uint64_t states, std::uint64_t transitions,
+                   std::size_t depth, bool complete, double wall_s);
+
+// Hash of LEN bytes at P (FNV-1a), combined with SEED.
+//
+std::uint64_t explore_hash(const std::uint8_t * p, std::size_t len,
+                           std::uint64_t seed);
+
+#if LIBTBX_SAVABLE
+
+// In-memory counterparts of VerilatedSave and VerilatedRestore; the buffer of
+// the serializer is drained to (and that of the deserializer refilled from) a
+// byte vector in place of a file.
+//
+class SnapshotSave : public VerilatedSerialize {
+ public:
+  void open(std::vector<std::uint8_t> & bytes) {
+    bytes_ = &bytes;
+    bytes_->clear();
+    m_isOpen = true;
+    header();
+  }
+
+  void close() override {
+    if (!isOpen())
+      return;
+    trailer();
+    flush();
+    m_isOpen = false;
+  }
+
+  void flush() override {
+    bytes_->insert(bytes_->end(), m_bufp, m_cp);
+    m_cp = m_bufp;
+  }
+
+ private:
+  std::vector<std::uint8_t> * bytes_{nullptr};
+};
+
+class SnapshotRestore : public VerilatedDeserialize {
+ public:
+  void open(const std::vector<std::uint8_t> & bytes) {
+    bytes_ = &bytes;
+    pos_ = 0;
+    m_cp = m_endp = m_bufp;
+    m_isOpen = true;
+    header();
+  }
+
+  void close() override {
+    if (!isOpen())
+      return;
+    trailer();
+    m_isOpen = false;
+  }
+
+ protected:
+  void fill() override {
+    std::uint8_t * rp = m_bufp;
+    for (std::uint8_t * sp = m_cp; sp < m_endp; *rp++ = *sp++) {}
+    m_endp = m_bufp + (m_endp - m_cp);
+    m_cp = m_bufp;
+    const std::size_t n = std::min<std::size_t>(
+        bytes_->size() - pos_, m_bufp + bufferSize() - m_endp);
+    std::copy(bytes_->begin() + pos_, bytes_->begin() + pos_ + n, m_endp);
+    m_endp += n;
+    pos_ += n;
+  }
+
+ private:
+  const std::vector<std::uint8_t> * bytes_{nullptr};
+  std::size_t pos_{0};
+};
+
+template <typename UUT, typename Ref, typename Reset, typename Step,
+          typename Idle>
+int explore(int argc, char ** argv, const std::vector<std::string> & choices,
+            Reset reset, Step step, Idle idle) {
+  using clock_type = std::chrono::steady_clock;
+
+  // A reachable state: the snapshot of the model and the reference, and the
+  // state (and choice) from which it was first reached.
+  //
+  struct State {
+    std::vector<std::uint8_t> snapshot;
+    Ref ref;
+    std::size_t parent;
+    std::size_t choice;
+  };
+
+  parse_knobs(argc, argv);
+  if (!report_knobs())
+    return 1;
+  const ExploreOptions & opts = explore_options();
+
+  UUT uut;
+  SnapshotSave os;
+  SnapshotRestore is;
+  std::vector<State> states;
+  std::unordered_multimap<std::uint64_t, std::size_t> seen;
+
+  auto visit = [&](const Ref & ref, std::size_t parent, std::size_t choice) {
+    State s{{}, ref, parent, choice};
+    idle(uut);
+    os.open(s.snapshot);
+    os << uut;
+    os.close();
+    const std::uint64_t key = ref.key();
+    const std::uint64_t h =
+        explore_hash(s.snapshot.data(), s.snapshot.size(), key);
+    const auto range = seen.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+      const State & t = states[it->second];
+      if ((t.ref.key() == key) && (t.snapshot == s.snapshot))
+        return;
+    }
+    seen.emplace(h, states.size());
+    states.push_back(std::move(s));
+  };
+
+  auto path_to = [&](std::size_t i) {
+    std::vector<std::size_t> path;
+    for (; states[i].parent != i; i = states[i].parent)
+      path.insert(path.begin(), states[i].choice);
+    return path;
+  };
+
+  const clock_type::time_point t0 = clock_type::now();
+  reset(uut);
+  visit(Ref{}, 0, 0);
+
+  // States are appended in order of discovery; those in [begin, end) form the
+  // frontier at the current depth.
+  //
+  std::uint64_t transitions = 0;
+  bool truncated = false;
+  std::size_t depth = 0;
+  std::size_t begin = 0;
+  std::string why;
+  std::vector<std::size_t> path;
+  while ((begin < states.size()) && (depth < opts.depth) && why.empty()) {
+    const std::size_t end = states.size();
+    for (std::size_t i = begin; (i < end) && why.empty(); i++) {
+      for (std::size_t c = 0; c < choices.size(); c++) {
+        if (!states[i].ref.allows(c))
+          continue;
+        is.open(states[i].snapshot);
+        is >> uut;
+        is.close();
+        Ref ref = states[i].ref;
+        ++transitions;
+        why = step(uut, ref, c);
+        if (!why.empty()) {
+          path = path_to(i);
+          path.push_back(c);
+          break;
+        }
+        if (states.size() < opts.states)
+          visit(ref, i, c);
+        else
+          truncated = true;
+      }
+    }
+    begin = end;
+    ++depth;
+  }
+  const std::chrono::duration<double> wall = clock_type::now() - t0;
+
+  uut.final();
+  return report_explore(why, path, choices, states.size(), transitions, depth,
+                        why.empty() && !truncated && (begin == states.size()),
+                        wall.count());
+}
+
+#endif
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,143 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_KNOB_H
+#define LIBTBX_KNOB_H
+
+#include <sstream>
+#include <string>
+
+// Runtime workload parameters. A knob is declared with a name, a typed default
+// and a description, and may be overridden without recompilation, either upon
+// the command line,
+//
+//   ./sorted_lists_fast +updates=1000000 +queries=1000000
+//
+// or through the environment,
+//
+//   LIBTBX_KNOBS="updates=1000000 queries=1000000" ./sorted_lists_fast
+//
+// (separated by whitespace, as a value may itself be a comma-separated list)
+// where the command line takes precedence. The value of every knob is reported
+// upon start of simulation; an override naming no knob, or whose value cannot
+// be parsed, is an error.
+//
+namespace libtbx {
+
+class KnobBase {
+ public:
+  KnobBase(const char * name, const char * description);
+  virtual ~KnobBase();
+
+  const std::string & name() const { return name_; }
+  const std::string & description() const { return description_; }
+
+  // Render the current and the default value of the knob.
+  //
+  virtual std::string value() const = 0;
+  virtual std::string default_value() const = 0;
+
+  // Whether an override was given, and if so whether it was valid.
+  //
+  virtual bool overridden() const = 0;
+  virtual bool valid() const = 0;
+
+  // The override of this knob, or nullptr.
+  //
+  const std::string * find_override() const;
+
+ private:
+  std::string name_;
+  std::string description_;
+};
+
+template <typename T>
+bool parse_knob(const std::string & s, T & t) {
+  std::istringstream ss{s};
+  ss >> t;
+  return !ss.fail() && (ss.peek() == std::char_traits<char>::eof());
+}
+
+bool parse_knob(const std::string & s, bool & t);
+bool parse_knob(const std::string & s, std::string & t);
+
+template <typename T>
+class Knob : public KnobBase {
+ public:
+  Knob(const char * name, const T & t, const char * description = "")
+      : KnobBase(name, description), default_(t), value_(t) {}
+
+  const T & get() const {
+    if (!resolved_)
+      resolve();
+    return value_;
+  }
+
+  operator const T & () const { return get(); }
+
+  std::string value() const override { return render(get()); }
+  std::string default_value() const override { return render(default_); }
+  bool overridden() const override { get(); return overridden_; }
+  bool valid() const override { get(); return valid_; }
+
+ private:
+  void resolve() const {
+    if (const std::string * s = find_override()) {
+      overridden_ = true;
+      valid_ = parse_knob(*s, value_);
+      if (!valid_)
+        value_ = default_;
+    }
+    resolved_ = true;
+  }
+
+  static std::string render(const T & t) {
+    std::ostringstream ss;
+    ss << std::boolalpha << t;
+    return ss.str();
+  }
+
+  T default_;
+  mutable T value_;
+  mutable bool resolved_{false};
+  mutable bool overridden_{false};
+  mutable bool valid_{true};
+};
+
+// Extract knob overrides ('+<name>=<value>') from the command line, removing
+// them from ARGV, and from LIBTBX_KNOBS. Returns the resultant argument count.
+//
+int parse_knobs(int argc, char ** argv);
+
+// Report the value of each knob. Returns false should any override name an
+// unknown knob or be invalid.
+//
+bool report_knobs();
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,206 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_MODEL_PIPELINE_H
+#define LIBTBX_MODEL_PIPELINE_H
+
+#include <libtbx/spsc.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace libtbx {
+
+// Evaluate a reference model upon its own OS thread, concurrently with the
+// simulation. Commands are issued by the testbench, in simulation order,
+// through push() (a command producing no result, for example a state update)
+// or push_expect() (a command producing exactly one result, for example a
+// query). The model is a callable,
+//
+//   void f(const Cmd & cmd, Result & result)
+//
+// invoked upon the model thread for each command, in order. Results are
+// retrieved, in order, by pop(), which blocks until the model has caught up.
+// Should results not be retrieved (for example, if the design under test
+// fails to respond), they are spilled to an unbounded queue upon the
+// simulation thread such that the model never stalls the simulation.
+//
+// When constructed with threaded == false, the model is instead evaluated
+// inline upon push; the testbench is otherwise unchanged.
+//
+// The model thread spins (then yields) only briefly upon an empty command
+// ring before parking upon a condition variable, such that it does not occupy
+// a core while the simulation issues no commands; the simulation thread wakes
+// it upon the next push.
+//
+// The model must not interact with the simulation kernel (in particular, it
+// must not report through LIBTB_REPORT_*) as it does not execute upon the
+// simulation thread.
+//
+template <typename Cmd, typename Result, std::size_t N = 4096>
+class ModelPipeline {
+  struct Entry {
+    Cmd cmd;
+    bool expect;
+    bool stop;
+  };
+
+  // Attempts upon an empty command ring before the model thread yields, and
+  // then parks.
+  //
+  static constexpr unsigned SPIN = 64;
+  static constexpr unsigned PARK = 1024;
+
+ public:
+  using model_type = std::function<void(const Cmd &, Result &)>;
+
+  explicit ModelPipeline(model_type f, bool threaded = true)
+      : f_(f), threaded_(threaded) {
+    if (threaded_)
+      worker_ = std::thread([this]() { run(); });
+  }
+
+  ~ModelPipeline() {
+    if (threaded_) {
+      send(Entry{Cmd(), false, true});
+      // Results are drained until the model has stopped, as it may otherwise
+      // stall upon a full result ring.
+      Result r;
+      while (!stopped_.load(std::memory_order_acquire)) {
+        while (out_.try_pop(r))
+          spill_.push_back(r);
+        std::this_thread::yield();
+      }
+      worker_.join();
+    }
+  }
+
+  bool threaded() const { return threaded_; }
+
+  void push(const Cmd & cmd) { issue(cmd, false); }
+
+  void push_expect(const Cmd & cmd) {
+    issue(cmd, true);
+    ++outstanding_;
+  }
+
+  // Number of results expected but not yet retrieved.
+  //
+  std::size_t outstanding() const { return outstanding_; }
+
+  Result pop() {
+    --outstanding_;
+    if (!spill_.empty()) {
+      Result r = spill_.front();
+      spill_.pop_front();
+      return r;
+    }
+    return out_.pop();
+  }
+
+ private:
+  void issue(const Cmd & cmd, bool expect) {
+    if (threaded_) {
+      send(Entry{cmd, expect, false});
+    } else {
+      Result r;
+      f_(cmd, r);
+      if (expect)
+        spill_.push_back(r);
+    }
+  }
+
+  void send(const Entry & e) {
+    Result r;
+    while (!in_.try_push(e)) {
+      // The model may be stalled upon a full result ring.
+      while (out_.try_pop(r))
+        spill_.push_back(r);
+      std::this_thread::yield();
+    }
+    // Paired with the fence in receive(): either the model observes the
+    // command before parking, or it is observed here to have parked.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+      { std::lock_guard<std::mutex> lk(park_mtx_); }
+      park_cv_.notify_one();
+    }
+  }
+
+  Entry receive() {
+    Entry e;
+    for (unsigned i = 0; !in_.try_pop(e); i++) {
+      if (i < SPIN)
+        continue;
+      if (i < PARK) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> lk(park_mtx_);
+      parked_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      park_cv_.wait(lk, [this]() { return !in_.empty(); });
+      parked_.store(false, std::memory_order_relaxed);
+      i = 0;
+    }
+    return e;
+  }
+
+  void run() {
+    while (true) {
+      const Entry e = receive();
+      if (e.stop) {
+        stopped_.store(true, std::memory_order_release);
+        break;
+      }
+      Result r;
+      f_(e.cmd, r);
+      if (e.expect)
+        out_.push(r);
+    }
+  }
+
+  model_type f_;
+  bool threaded_;
+  std::size_t outstanding_{0};
+  std::atomic<bool> stopped_{false};
+  std::atomic<bool> parked_{false};
+  std::mutex park_mtx_;
+  std::condition_variable park_cv_;
+  std::deque<Result> spill_;
+  SpscRing<Entry, N> in_;
+  SpscRing<Result, N> out_;
+  std::thread worker_;
+};
+
+} // namespace libtbx
+
+#endif
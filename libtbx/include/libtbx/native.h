@@ -0,0 +1,206 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_NATIVE_H
+#define LIBTBX_NATIVE_H
+
+#include <libtb.h>
+#include <libtbx/knob.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Native simulation backend. The model is verilated as plain C++ (--cc) and
+// advanced by a cycle loop which toggles 'clk' and calls eval(), bypassing the
+// SystemC kernel. SystemC is nonetheless linked: libtb reports through
+// sc_report_handler, whose error count decides pass/fail. Testbench processes
+// are cooperative threads, each upon its own stack, scheduled at posedge of
+// the clock. The semantics of libtb are retained:
+//
+//   * the design is held in reset for the first RESET_CYCLES cycles;
+//   * t_wait_posedge_clk(n) blocks the calling thread for n posedges;
+//   * stimulus driven after a posedge is visible to the model at the next;
+//   * sample methods (e_tb_sample) are invoked once per cycle, after all
+//     threads have run and the model has settled.
+//
+// Testbenches select the backend through the macros in <libtbx/backend.h>.
+//
+namespace libtbx {
+namespace native {
+
+class Process;
+
+// Number of cycles for which reset is asserted at the start of simulation.
+//
+constexpr int RESET_CYCLES = 10;
+
+// Equivalent to sc_core::sc_event for the purposes of thread synchronization;
+// notification is immediate and wakes all waiting threads within the current
+// cycle.
+//
+class Event {
+  friend class TopLevel;
+ public:
+  void notify();
+ private:
+  std::vector<Process *> waiters_;
+};
+
+// A signal bound directly to a port of the verilated model. Verilator
+// represents ports as the smallest of CData, SData, IData and QData which
+// accommodates the port; T is the type presented to the testbench and is
+// converted accordingly. Wide ports (VlWide) are not supported.
+//
+template <typename T>
+class Signal {
+ public:
+  Signal(const char * = "") {}
+
+  template <typename P>
+  void bind(P & p) {
+    static_assert(std::is_integral<P>::value,
+                  "native backend supports ports of at most 64 bits");
+    p_ = std::addressof(p);
+    bytes_ = sizeof(P);
+  }
+
+  T read() const {
+    switch (bytes_) {
+      case 1: return static_cast<T>(*static_cast<const std::uint8_t *>(p_));
+      case 2: return static_cast<T>(*static_cast<const std::uint16_t *>(p_));
+      case 4: return static_cast<T>(*static_cast<const std::uint32_t *>(p_));
+      default: return static_cast<T>(*static_cast<const std::uint64_t *>(p_));
+    }
+  }
+
+  void write(const T & t) {
+    switch (bytes_) {
+      case 1: *static_cast<std::uint8_t *>(p_) = t; break;
+      case 2: *static_cast<std::uint16_t *>(p_) = t; break;
+      case 4: *static_cast<std::uint32_t *>(p_) = t; break;
+      default: *static_cast<std::uint64_t *>(p_) = t; break;
+    }
+  }
+
+  operator T() const { return read(); }
+  Signal & operator=(const T & t) { write(t); return *this; }
+
+ private:
+  void * p_{nullptr};
+  std::size_t bytes_{0};
+};
+
+// Counterpart of libtb::TopLevel. Exactly one instance is constructed by
+// libtbx::Sim<T>, and becomes the top of the simulation.
+//
+class TopLevel {
+  friend int start();
+ public:
+  TopLevel(const char * name = "t");
+  virtual ~TopLevel();
+
+  virtual bool run_test() = 0;
+
+  void t_wait_reset_done();
+  void t_wait_posedge_clk(int n = 1);
+  void wait(Event & e);
+
+  // Number of posedges since the start of simulation.
+  //
+  std::uint64_t cycle() const { return cycle_; }
+
+  bool is_reset_done() const { return reset_done_; }
+
+  // Register F to be invoked once per cycle, at posedge, ahead of any thread.
+  //
+  void on_posedge(std::function<void()> f);
+
+  // Register F as a sample method, invoked once per cycle.
+  //
+  void on_sample(std::function<void()> f);
+
+ protected:
+  // Bind the model. UUT is expected to present 1b 'clk' and 'rst' inputs.
+  //
+  template <typename UUT>
+  void bind_uut(UUT & uut) {
+    uut_ = std::addressof(uut);
+    clk_ = std::addressof(uut.clk);
+    rst_ = std::addressof(uut.rst);
+    eval_ = [](void * p) { static_cast<UUT *>(p)->eval(); };
+    final_ = [](void * p) { static_cast<UUT *>(p)->final(); };
+  }
+
+  // Register F as a thread, launched at the start of simulation.
+  //
+  void spawn(std::function<void()> f);
+
+ private:
+  void eval();
+  void schedule();
+  void yield();
+  void simulate();
+
+  void * uut_{nullptr};
+  std::uint8_t * clk_{nullptr};
+  std::uint8_t * rst_{nullptr};
+  void (*eval_)(void *){nullptr};
+  void (*final_)(void *){nullptr};
+
+  std::uint64_t cycle_{0};
+  bool reset_done_{false};
+  Event e_reset_done_;
+  Process * current_{nullptr};
+  std::vector<Process *> procs_;
+  std::vector<std::function<void()> > posedges_;
+  std::vector<std::function<void()> > samplers_;
+};
+
+// Run the simulation of the constructed TopLevel until its run_test() returns.
+// Returns non-zero if errors were reported.
+//
+int start();
+
+template <typename T>
+class Sim {
+ public:
+  Sim(int argc, char ** argv) {
+    libtb::LibTbContext::init(parse_knobs(argc, argv), argv);
+  }
+
+  int start() {
+    T top;
+    return native::start();
+  }
+};
+
+} // namespace native
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,124 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_PROFILE_H
+#define LIBTBX_PROFILE_H
+
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#endif
+
+// Wall-time profile of the simulation thread. Regions of the testbench are
+// attributed to named zones by way of LIBTBX_PROFILE_SCOPE; time not within any
+// zone is attributed to the zone 'kernel' (the simulation kernel and, where not
+// separately attributed, evaluation of the model). Time is exclusive: upon
+// entry to a nested zone, time accrues to the inner zone alone.
+//
+// Profiling is enabled by the knob 'profile', in which case a breakdown by
+// zone is reported upon completion of the simulation. When disabled, the cost
+// of a scope is a single test.
+//
+// Scopes must not span a wait upon the simulation kernel, and are not to be
+// used off the simulation thread.
+//
+namespace libtbx {
+
+class ProfileZone {
+ public:
+  explicit ProfileZone(const char * name);
+
+  const char * name() const { return name_; }
+
+  std::uint64_t ticks{0};
+  std::uint64_t calls{0};
+
+ private:
+  const char * name_;
+};
+
+extern bool profile_enabled;
+extern ProfileZone * profile_current;
+extern std::uint64_t profile_last;
+
+inline std::uint64_t profile_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+class ProfileScope {
+ public:
+  explicit ProfileScope(ProfileZone & z) {
+    if (profile_enabled) {
+      const std::uint64_t t = profile_ticks();
+      profile_current->ticks += (t - profile_last);
+      parent_ = profile_current;
+      profile_current = &z;
+      profile_last = t;
+      ++z.calls;
+    }
+  }
+
+  ~ProfileScope() {
+    if (parent_ != nullptr) {
+      const std::uint64_t t = profile_ticks();
+      profile_current->ticks += (t - profile_last);
+      profile_current = parent_;
+      profile_last = t;
+    }
+  }
+
+ private:
+  ProfileZone * parent_{nullptr};
+};
+
+// Commence profiling (should the 'profile' knob be set).
+//
+void profile_begin();
+
+// Conclude profiling and report the breakdown over the elapsed WALL_S seconds
+// and CYCLES simulated cycles.
+//
+void profile_report(double cycles, double wall_s);
+
+} // namespace libtbx
+
+#define LIBTBX_PROFILE_CAT_(__a, __b) __a##__b
+#define LIBTBX_PROFILE_CAT(__a, __b) LIBTBX_PROFILE_CAT_(__a, __b)
+
+// Attribute the remainder of the enclosing block to the zone __name.
+//
+#define LIBTBX_PROFILE_SCOPE(__name)                                    \
+  static libtbx::ProfileZone LIBTBX_PROFILE_CAT(__zone, __LINE__){__name}; \
+  libtbx::ProfileScope LIBTBX_PROFILE_CAT(__scope, __LINE__){          \
+    LIBTBX_PROFILE_CAT(__zone, __LINE__)}
+
+#endif
@@ -0,0 +1,224 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_RANDOM_H
+#define LIBTBX_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Bulk random stimulus. libtb::random<T>() returns a single value per call;
+// testbenches issuing a transaction per cycle instead pre-generate blocks of
+// stimulus from a libtbx::Rng:
+//
+//   Rng rng_;
+//   ...
+//   std::uint32_t x[256];
+//   rng_.fill(x, 256);                    // Words
+//   rng_.fill_bounded(x, 256, 100);       // Integers in [0, 100)
+//   std::uint64_t v[2];
+//   rng_.fill_bernoulli(v, 2, 0.8);       // Bits, each set with p = 0.8
+//
+// The generator is xoshiro256++, evaluated upon LANES independent states laid
+// out such that the compiler vectorizes the update (the fast and PGO models
+// are compiled with -march=native). The lanes, and any number of streams, are
+// separated by the jump functions of the generator and therefore do not
+// overlap; a stream may be given to each thread.
+//
+// By default, a generator is seeded from the libtb generator upon its first
+// use (by which time libtb has been seeded), such that stimulus is
+// reproducible from the seed of the test.
+//
+namespace libtbx {
+
+// Seed from which generators are derived by default. Drawn once from the libtb
+// generator; the first call must be made from the simulation thread once
+// simulation has begun.
+//
+std::uint64_t test_seed();
+
+class Rng {
+ public:
+  static constexpr std::size_t LANES = 8;
+
+  // Stream STREAM of the generator seeded by test_seed().
+  //
+  explicit Rng(std::uint64_t stream = 0) : stream_(stream) {}
+
+  // Stream STREAM of the generator seeded by SEED.
+  //
+  Rng(std::uint64_t seed, std::uint64_t stream)
+      : stream_(stream) { seed_state(seed); }
+
+  std::uint64_t next() {
+    if (pos_ == LANES) {
+      step(buf_);
+      pos_ = 0;
+    }
+    return buf_[pos_++];
+  }
+
+  // Integer in [0, BOUND).
+  //
+  std::uint64_t bounded(std::uint64_t bound) { return scale(next(), bound); }
+
+  // True with probability P.
+  //
+  bool bernoulli(double p) { return (next() >> 11) < threshold53(p); }
+
+  void fill(std::uint64_t * p, std::size_t n) {
+    std::size_t i = 0;
+    for (; (i < n) && (pos_ != LANES); i++)
+      p[i] = buf_[pos_++];
+    for (; i + LANES <= n; i += LANES)
+      step(p + i);
+    for (; i < n; i++)
+      p[i] = next();
+  }
+
+  void fill(std::uint32_t * p, std::size_t n) {
+    std::uint64_t w[BLOCK];
+    for (std::size_t i = 0; i < n; i += 2 * BLOCK) {
+      const std::size_t m = min(n - i, 2 * BLOCK);
+      fill(w, (m + 1) / 2);
+      for (std::size_t j = 0; j < m; j++)
+        p[i + j] = static_cast<std::uint32_t>(w[j / 2] >> (32 * (j & 1)));
+    }
+  }
+
+  // Integers in [0, BOUND), by multiplication rather than division; the
+  // bias, at most BOUND / 2^64, is immaterial to stimulus.
+  //
+  template <typename T>
+  void fill_bounded(T * p, std::size_t n, std::uint64_t bound) {
+    std::uint64_t w[BLOCK];
+    for (std::size_t i = 0; i < n; i += BLOCK) {
+      const std::size_t m = min(n - i, BLOCK);
+      fill(w, m);
+      for (std::size_t j = 0; j < m; j++)
+        p[i + j] = static_cast<T>(scale(w[j], bound));
+    }
+  }
+
+  // N words of independent bits, each set with probability P (to a precision
+  // of 2^-32). Each word costs one draw per significant binary digit of P:
+  // one for P = 0.5, two for 0.25 or 0.75, and so on.
+  //
+  void fill_bernoulli(std::uint64_t * p, std::size_t n, double prob) {
+    const std::uint64_t q = threshold32(prob);
+    if (q == 0 || q == (std::uint64_t{1} << 32)) {
+      for (std::size_t i = 0; i < n; i++)
+        p[i] = (q == 0) ? 0 : ~std::uint64_t{0};
+      return;
+    }
+    // With P = 0.b1 b2 ... bk (bk the least significant set digit), a word
+    // drawn for bk is successively OR-ed (bi set) or AND-ed (bi clear) with
+    // a fresh word for each more significant digit.
+    //
+    int lsb = 0;
+    while (((q >> lsb) & 1) == 0)
+      ++lsb;
+    std::uint64_t r[BLOCK];
+    for (std::size_t i = 0; i < n; i += BLOCK) {
+      const std::size_t m = min(n - i, BLOCK);
+      fill(p + i, m);
+      for (int b = lsb + 1; b < 32; b++) {
+        fill(r, m);
+        if ((q >> b) & 1)
+          for (std::size_t j = 0; j < m; j++)
+            p[i + j] |= r[j];
+        else
+          for (std::size_t j = 0; j < m; j++)
+            p[i + j] &= r[j];
+      }
+    }
+  }
+
+ private:
+  static constexpr std::size_t BLOCK = 64;
+
+  static std::size_t min(std::size_t a, std::size_t b) {
+    return (a < b) ? a : b;
+  }
+
+  static std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  static std::uint64_t scale(std::uint64_t x, std::uint64_t bound) {
+    return static_cast<std::uint64_t>(
+        (static_cast<unsigned __int128>(x) * bound) >> 64);
+  }
+
+  static std::uint64_t threshold32(double p) {
+    if (!(p > 0))
+      return 0;
+    if (p >= 1)
+      return std::uint64_t{1} << 32;
+    return static_cast<std::uint64_t>(p * 4294967296.0 + 0.5);
+  }
+
+  static std::uint64_t threshold53(double p) {
+    if (!(p > 0))
+      return 0;
+    if (p >= 1)
+      return std::uint64_t{1} << 53;
+    return static_cast<std::uint64_t>(p * 9007199254740992.0);
+  }
+
+  // Advance each lane, writing one word per lane to OUT.
+  //
+  void step(std::uint64_t * out) {
+    if (!seeded_)
+      seed_state(test_seed());
+    for (std::size_t l = 0; l < LANES; l++) {
+      out[l] = rotl(s0_[l] + s3_[l], 23) + s0_[l];
+      const std::uint64_t t = s1_[l] << 17;
+      s2_[l] ^= s0_[l];
+      s3_[l] ^= s1_[l];
+      s1_[l] ^= s2_[l];
+      s0_[l] ^= s3_[l];
+      s2_[l] ^= t;
+      s3_[l] = rotl(s3_[l], 45);
+    }
+  }
+
+  void seed_state(std::uint64_t seed);
+
+  std::uint64_t stream_;
+  bool seeded_{false};
+  std::size_t pos_{LANES};
+  std::uint64_t buf_[LANES];
+  std::uint64_t s0_[LANES];
+  std::uint64_t s1_[LANES];
+  std::uint64_t s2_[LANES];
+  std::uint64_t s3_[LANES];
+};
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,77 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_REPORT_H
+#define LIBTBX_REPORT_H
+
+#include <libtb.h>
+#include <sstream>
+
+// Report levels, in order of increasing severity.
+//
+#define LIBTBX_LEVEL_DEBUG 0
+#define LIBTBX_LEVEL_INFO 1
+#define LIBTBX_LEVEL_WARNING 2
+#define LIBTBX_LEVEL_ERROR 3
+
+// Compile-time minimum report level. At LIBTBX_LEVEL_INFO, debug reports
+// (LIBTBX_REPORT_DEBUG), together with the formatting of their messages, are
+// removed entirely; higher levels are always reported.
+//
+#ifndef LIBTBX_REPORT_MIN_LEVEL
+#  define LIBTBX_REPORT_MIN_LEVEL LIBTBX_LEVEL_DEBUG
+#endif
+#if LIBTBX_REPORT_MIN_LEVEL > LIBTBX_LEVEL_INFO
+#  error "LIBTBX_REPORT_MIN_LEVEL must be LIBTBX_LEVEL_DEBUG or LIBTBX_LEVEL_INFO"
+#endif
+
+namespace libtbx {
+
+// True if debug reports are emitted at the current verbosity.
+//
+inline bool debug_enabled() {
+  return (LIBTBX_LEVEL_DEBUG >= LIBTBX_REPORT_MIN_LEVEL) &&
+      (sc_core::sc_report_handler::get_verbosity_level() >= sc_core::SC_DEBUG);
+}
+
+} // namespace libtbx
+
+// Lazily formatted counterpart of LIBTB_REPORT_DEBUG. The argument is a
+// stream expression, evaluated only when debug reports are enabled:
+//
+//   LIBTBX_REPORT_DEBUG("Issue command: ID=" << id << " OP=" << op);
+//
+#define LIBTBX_REPORT_DEBUG(__msg)                      \
+  do {                                                  \
+    if (libtbx::debug_enabled()) {                      \
+      std::stringstream __libtbx_ss;                    \
+      __libtbx_ss << __msg;                             \
+      LIBTB_REPORT_DEBUG(__libtbx_ss.str());            \
+    }                                                   \
+  } while (false)
+
+#endif
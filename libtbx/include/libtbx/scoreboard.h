@@ -0,0 +1,192 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_SCOREBOARD_H
+#define LIBTBX_SCOREBOARD_H
+
+#include <libtb.h>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace libtbx {
+
+// Comparison and rendering of scoreboard entries. Specialize, or pass an
+// alternate Traits to Scoreboard, for types which do not support operator==
+// and operator<<.
+//
+template <typename T>
+struct ScoreboardTraits {
+  template <typename U>
+  static bool equal(const T & expected, const U & actual) {
+    return expected == actual;
+  }
+
+  template <typename U>
+  static void render(std::ostream & os, const U & u) { os << u; }
+};
+
+// Statistics common to all scoreboards. Live scoreboards are reported upon
+// completion of the simulation (see report_scoreboards()).
+//
+class ScoreboardBase {
+ public:
+  explicit ScoreboardBase(const char * name);
+  virtual ~ScoreboardBase();
+
+  const std::string & name() const { return name_; }
+  std::uint64_t matched() const { return matched_; }
+  std::uint64_t mismatched() const { return mismatched_; }
+  std::uint64_t underflows() const { return underflows_; }
+  std::uint64_t overflows() const { return overflows_; }
+  virtual std::size_t size() const = 0;
+
+  // Discard outstanding expectations; statistics are retained.
+  //
+  virtual void clear() = 0;
+
+ protected:
+  void report_underflow();
+  void report_overflow();
+
+  std::string name_;
+  std::uint64_t matched_{0};
+  std::uint64_t mismatched_{0};
+  std::uint64_t underflows_{0};
+  std::uint64_t overflows_{0};
+};
+
+// In-order scoreboard of expected values, retained in a preallocated ring
+// buffer of N (a power of two) entries. Matched entries are retired without
+// allocation or formatting; messages are formatted only upon error.
+//
+//   Scoreboard<uint32_t> expected_{"count_zeros"};
+//   ...
+//   expected_.push(cnt);      // Upon issue
+//   expected_.check(y_);      // Upon retirement
+//
+// Underflow (retirement with no outstanding expectation) and overflow (more
+// than N outstanding expectations) are reported as errors. An entry pushed
+// upon overflow is discarded.
+//
+template <typename T, std::size_t N = 1024,
+          typename Traits = ScoreboardTraits<T> >
+class Scoreboard : public ScoreboardBase {
+  static_assert((N != 0) && ((N & (N - 1)) == 0),
+                "Scoreboard capacity must be a power of two");
+
+ public:
+  explicit Scoreboard(const char * name = "scoreboard")
+      : ScoreboardBase(name), buf_(new T[N]) {}
+
+  static constexpr std::size_t capacity() { return N; }
+  std::size_t size() const override { return tail_ - head_; }
+  bool empty() const { return head_ == tail_; }
+  bool full() const { return size() == N; }
+  void clear() override { head_ = tail_; }
+
+  void push(const T & t) {
+    if (full()) {
+      report_overflow();
+      return;
+    }
+    buf_[tail_++ & (N - 1)] = t;
+  }
+
+  // Oldest outstanding expectation; the scoreboard must not be empty.
+  //
+  const T & front() const { return buf_[head_ & (N - 1)]; }
+
+  // Retire the oldest expectation without comparison. Returns false upon
+  // underflow.
+  //
+  bool pop() {
+    if (empty()) {
+      report_underflow();
+      return false;
+    }
+    ++head_;
+    return true;
+  }
+
+  // Retire the oldest expectation against ACTUAL. Returns true on a match. A
+  // mismatch is reported as an error rendering both values.
+  //
+  template <typename U>
+  bool check(const U & actual) {
+    return check(actual, [&](const T & expected) {
+        std::stringstream ss;
+        ss << name_ << ": mismatch detected: Actual: ";
+        Traits::render(ss, actual);
+        ss << " Expected: ";
+        Traits::render(ss, expected);
+        LIBTB_REPORT_ERROR(ss.str());
+      });
+  }
+
+  // As above, but upon mismatch ON_MISMATCH is invoked with the expected
+  // value and is responsible for reporting the error.
+  //
+  template <typename U, typename F>
+  bool check(const U & actual, F on_mismatch) {
+    if (empty()) {
+      report_underflow();
+      return false;
+    }
+    const T & expected = front();
+    const bool eq = Traits::equal(expected, actual);
+    if (eq)
+      ++matched_;
+    else {
+      ++mismatched_;
+      on_mismatch(expected);
+    }
+    ++head_;
+    return eq;
+  }
+
+ private:
+  std::unique_ptr<T[]> buf_;
+  std::uint64_t head_{0};
+  std::uint64_t tail_{0};
+};
+
+// Report the statistics of each live scoreboard, one line per scoreboard
+// prefixed with "[libtbx]". Called upon completion of the simulation.
+//
+void report_scoreboards();
+
+// Discard the outstanding expectations of each live scoreboard, returning the
+// total discarded. Called between tests (see <libtbx/testlist.h>).
+//
+std::size_t clear_scoreboards();
+
+} // namespace libtbx
+
+#endif
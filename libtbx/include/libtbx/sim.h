@@ -0,0 +1,107 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_SIM_H
+#define LIBTBX_SIM_H
+
+#include <libtb.h>
+#include <libtbx/knob.h>
+#include <functional>
+
+#if LIBTBX_BACKEND_NATIVE
+#  include <libtbx/native.h>
+#endif
+
+namespace libtbx {
+
+// Emit run statistics: the number of simulated clock cycles, the elapsed
+// wall-clock time and the consequent simulation rate. The report is emitted on
+// a single line prefixed with "[libtbx]" such that it can be scraped by the
+// benchmarking scripts.
+//
+void report(double cycles, double wall_s);
+
+// Register F to be invoked, with the number of simulated clock cycles, upon
+// completion of the simulation; after the scoreboards and coverage are
+// reported and before the run statistics. Such reports therefore precede the
+// final "[libtbx]" line scraped by the benchmarking scripts.
+//
+void on_complete(const std::function<void(double cycles)> & f);
+
+// Invoke each function registered by on_complete(), in order of registration.
+//
+void complete(double cycles);
+
+// Report the value of each knob then invoke the simulation kernel through F
+// and, upon completion, report run statistics.
+//
+int run(const std::function<int()> & f);
+
+// Equivalent to libtb::LibTbContext::start() with run statistics. For use by
+// testbenches which construct their top-level and initialize the context
+// explicitly.
+//
+int start();
+
+#if !LIBTBX_BACKEND_NATIVE
+
+// The clock of the design (by construction, that instantiated by
+// libtb::TopLevel), or nullptr. Valid once elaboration is complete.
+//
+const sc_core::sc_clock * design_clock();
+
+#endif
+
+#if LIBTBX_BACKEND_NATIVE
+
+template <typename T>
+using Sim = native::Sim<T>;
+
+#else
+
+// Drop-in replacement for libtb::LibTbSim<T>, reporting run statistics upon
+// completion of the simulation. Knob overrides are removed from the command
+// line before it is passed to libtb.
+//
+template <typename T>
+class Sim {
+ public:
+  Sim(int argc, char **argv) : sim_(parse_knobs(argc, argv), argv) {}
+
+  int start() {
+    return run([this]() { return sim_.start(); });
+  }
+
+ private:
+  libtb::LibTbSim<T> sim_;
+};
+
+#endif
+
+} // namespace libtbx
+
+#endif
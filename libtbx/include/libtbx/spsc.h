@@ -0,0 +1,120 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_SPSC_H
+#define LIBTBX_SPSC_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace libtbx {
+
+// Bounded, lock-free, single-producer/single-consumer ring of N (a power of
+// two) entries. The producer and consumer indices are kept upon separate cache
+// lines, and each side retains a cached copy of the other's index such that
+// the shared line is touched only when the ring appears full (or empty).
+//
+template <typename T, std::size_t N>
+class SpscRing {
+  static_assert((N != 0) && ((N & (N - 1)) == 0),
+                "SpscRing capacity must be a power of two");
+
+  static constexpr std::size_t LINE = 64;
+
+ public:
+  SpscRing() : buf_(new T[N]) {}
+
+  static constexpr std::size_t capacity() { return N; }
+
+  // Producer.
+  //
+  bool try_push(const T & t) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if ((tail - head_cache_) == N) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if ((tail - head_cache_) == N)
+        return false;
+    }
+    buf_[tail & (N - 1)] = t;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  void push(const T & t) {
+    for (unsigned i = 0; !try_push(t); i++)
+      backoff(i);
+  }
+
+  // Consumer.
+  //
+  bool try_pop(T & t) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_)
+        return false;
+    }
+    t = std::move(buf_[head & (N - 1)]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  T pop() {
+    T t;
+    for (unsigned i = 0; !try_pop(t); i++)
+      backoff(i);
+    return t;
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+        tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // Spin briefly before relinquishing the core, such that progress is made
+  // when producer and consumer share a core.
+  //
+  static void backoff(unsigned i) {
+    if (i >= 64)
+      std::this_thread::yield();
+  }
+
+  std::atomic<std::size_t> head_{0};
+  std::size_t tail_cache_{0};
+  char pad0_[LINE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+  std::atomic<std::size_t> tail_{0};
+  std::size_t head_cache_{0};
+  char pad1_[LINE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+  std::unique_ptr<T[]> buf_;
+};
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,147 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_SWEEP_H
+#define LIBTBX_SWEEP_H
+
+#include <libtbx/knob.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Exhaustive sweep of a combinational model. Rather than apply a sample of its
+// input space at one input per simulated cycle, every input in [0, N) is
+// applied to a plain (--cc) verilated model by a tight loop of eval() calls,
+// without a clock or simulation kernel. The space is partitioned in chunks
+// across worker threads, each upon its own instance of the model:
+//
+//   int sc_main(int argc, char ** argv) {
+//     return libtbx::sweep<Vincrement>(argc, argv, std::uint64_t{1} << 32,
+//       [](Vincrement & uut, std::uint64_t i) {
+//         uut.A = static_cast<std::uint32_t>(i);
+//         uut.eval();
+//         return !uut.fail;
+//       });
+//   }
+//
+// APPLY drives input I, evaluates the model and returns true if the model
+// passes. Failing inputs are reported (up to the knob 'sweep_report'),
+// followed by a summary line prefixed by "[libtbx] sweep". The knob
+// 'sweep_threads' sets the number of workers (default: all cores) and
+// 'sweep_inputs' may truncate the space.
+//
+// Answers opt in by passing SWEEP to EMIT_ANSWER, which emits <answer>_sweep
+// from <answer>_sweep.cpp.
+//
+namespace libtbx {
+
+struct SweepOptions {
+  unsigned threads;
+  std::uint64_t inputs;
+  std::size_t report;
+};
+
+const SweepOptions & sweep_options();
+
+// Report the failing inputs FAILS (of FAILED in total) of a sweep of N inputs,
+// and the summary. Returns non-zero if any input failed.
+//
+int report_sweep(std::vector<std::uint64_t> & fails, std::uint64_t failed,
+                 std::uint64_t n, unsigned threads, double wall_s);
+
+template <typename UUT, typename Apply>
+int sweep(int argc, char ** argv, std::uint64_t n, Apply apply) {
+  using clock_type = std::chrono::steady_clock;
+  constexpr std::uint64_t CHUNK = std::uint64_t{1} << 16;
+
+  parse_knobs(argc, argv);
+  if (!report_knobs())
+    return 1;
+
+  const SweepOptions & opts = sweep_options();
+  if ((opts.inputs != 0) && (opts.inputs < n))
+    n = opts.inputs;
+  const std::uint64_t chunks = (n + CHUNK - 1) / CHUNK;
+  unsigned threads = opts.threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned>(
+      std::min<std::uint64_t>(threads, std::max<std::uint64_t>(chunks, 1)));
+
+  // Models are constructed upon the calling thread; thereafter each is
+  // evaluated by its worker alone.
+  //
+  std::vector<std::unique_ptr<UUT> > uuts;
+  for (unsigned t = 0; t < threads; t++)
+    uuts.emplace_back(new UUT);
+
+  std::atomic<std::uint64_t> next{0};
+  std::atomic<std::uint64_t> failed{0};
+  std::mutex m;
+  std::vector<std::uint64_t> fails;
+
+  auto worker = [&](UUT & uut) {
+    std::vector<std::uint64_t> local;
+    std::uint64_t local_failed = 0;
+    for (std::uint64_t c; (c = next.fetch_add(1)) < chunks;) {
+      const std::uint64_t hi = std::min(n, (c + 1) * CHUNK);
+      for (std::uint64_t i = c * CHUNK; i < hi; i++) {
+        if (!apply(uut, i)) {
+          if (local.size() < opts.report)
+            local.push_back(i);
+          ++local_failed;
+        }
+      }
+    }
+    failed += local_failed;
+    std::lock_guard<std::mutex> lock(m);
+    fails.insert(fails.end(), local.begin(), local.end());
+  };
+
+  const clock_type::time_point t0 = clock_type::now();
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; t++)
+    workers.emplace_back(worker, std::ref(*uuts[t]));
+  worker(*uuts[0]);
+  for (std::thread & t : workers)
+    t.join();
+  const std::chrono::duration<double> wall = clock_type::now() - t0;
+
+  for (std::unique_ptr<UUT> & uut : uuts)
+    uut->final();
+  return report_sweep(fails, failed, n, threads, wall.count());
+}
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,125 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_TESTLIST_H
+#define LIBTBX_TESTLIST_H
+
+#include <libtbx/backend.h>
+#include <libtbx/knob.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace libtbx {
+
+// Directed tests run back to back within a single simulation, such that the
+// cost of elaboration and of simulator startup is paid once per list rather
+// than once per test. Tests are registered in order upon construction of the
+// testbench and run from run_test():
+//
+//   TestList tests_{[this]() { b_reset(); }};
+//   ...
+//   tests_.add("test_0", [this]() { test_0(); });
+//   tests_.add("test_1", [this]() { test_1(); });
+//   ...
+//   bool run_test() { tests_.run(); return false; }
+//
+// A test is to return once its responses have drained: expectations still
+// outstanding at that point fail the test. Between consecutive tests they are
+// discarded and RESET is invoked, from the thread of run_test(), to return the
+// design and the testbench to their initial state (see TestReset).
+//
+// The knob 'tests' selects the tests run, and their order; by default, all are
+// run in order of registration. The outcome of each test is reported upon a
+// line prefixed by "[libtbx]".
+//
+class TestList {
+ public:
+  explicit TestList(std::function<void()> reset);
+
+  void add(const char * name, std::function<void()> f);
+
+  // Run the selected tests. Returns false if the selection names an unknown
+  // test, in which case no test is run.
+  //
+  bool run();
+
+ private:
+  struct Test {
+    std::string name;
+    std::function<void()> f;
+  };
+
+  const Knob<std::string> select_{
+    "tests", "", "Comma-separated tests run (default: all)"};
+  std::function<void()> reset_;
+  std::vector<Test> tests_;
+};
+
+#if !LIBTBX_BACKEND_NATIVE
+
+// In-place reset of the design between tests. The reset port of the design
+// is bound to rst() in place of libtb::TopLevel::rst(), which it follows, and
+// is additionally asserted by b_reset().
+//
+class TestReset : public sc_core::sc_module {
+ public:
+  SC_HAS_PROCESS(TestReset);
+  TestReset(sc_core::sc_module_name mn, libtb::TopLevel & top)
+      : sc_core::sc_module(mn), clk_(top.clk()), rst_in_(top.rst()),
+        rst_("rst"), req_("req") {
+    SC_METHOD(m_rst);
+    sensitive << rst_in_ << req_;
+  }
+
+  sc_core::sc_signal<bool> & rst() { return rst_; }
+
+  // Assert reset for N cycles, returning upon the first cycle out of reset.
+  // To be called from a thread.
+  //
+  void b_reset(int n = 10) {
+    req_ = true;
+    for (int i = 0; i < n; i++)
+      wait(clk_.posedge_event());
+    req_ = false;
+    wait(clk_.posedge_event());
+  }
+
+ private:
+  void m_rst() { rst_ = rst_in_.read() || req_.read(); }
+
+  const sc_core::sc_clock & clk_;
+  const sc_core::sc_signal<bool> & rst_in_;
+  sc_core::sc_signal<bool> rst_;
+  sc_core::sc_signal<bool> req_;
+};
+
+#endif
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,132 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_TRACE_H
+#define LIBTBX_TRACE_H
+
+#include <libtb.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if VM_TRACE && !LIBTBX_BACKEND_NATIVE
+#  include <libtbx/sim.h>
+#  include <verilated_fst_sc.h>
+#endif
+
+// Waveform tracing of a verilated model, disabled by default. Tracing is
+// enabled by the knob 'trace', naming the (FST) output file, and may be
+// restricted to a window of cycles, [trace_start, trace_stop) where a stop of
+// zero denotes the end of simulation, and to a comma-separated list of
+// hierarchical scopes, trace_scopes:
+//
+//   ./multi_counter +trace=multi_counter.fst +trace_start=1000 +trace_stop=2000
+//
+// Only the traced (default) model of each answer may be traced.
+//
+namespace libtbx {
+
+struct TraceOptions {
+  std::string file;
+  std::uint64_t start;
+  std::uint64_t stop;
+  std::vector<std::string> scopes;
+};
+
+const TraceOptions & trace_options();
+
+// Report that tracing was requested of a model which is not traced.
+//
+void trace_unavailable();
+
+#if VM_TRACE && !LIBTBX_BACKEND_NATIVE
+
+template <typename UUT>
+class Trace : public sc_core::sc_module {
+ public:
+  SC_HAS_PROCESS(Trace);
+  Trace(sc_core::sc_module_name mn, UUT & uut) : sc_module(mn), uut_(uut) {}
+
+  ~Trace() {
+    if (fst_)
+      fst_->close();
+  }
+
+ private:
+  // The knobs are consulted once elaboration is complete, by which point they
+  // have been parsed even should the testbench be constructed first; the
+  // model is not evaluated before then.
+  //
+  void before_end_of_elaboration() override {
+    if (!trace_options().file.empty()) {
+      Verilated::traceEverOn(true);
+      SC_THREAD(t_trace);
+    }
+  }
+
+  void t_trace() {
+    const TraceOptions & opts = trace_options();
+    const sc_core::sc_time period = design_clock()->period();
+
+    // The model must have been evaluated before its trace is constructed.
+    wait(sc_core::SC_ZERO_TIME);
+    if (opts.start != 0)
+      wait(static_cast<double>(opts.start) * period);
+
+    fst_.reset(new VerilatedFstSc);
+    uut_.trace(fst_.get(), 99);
+    for (const std::string & scope : opts.scopes)
+      fst_->dumpvars(0, scope);
+    fst_->open(opts.file.c_str());
+
+    if (opts.stop > opts.start) {
+      wait(static_cast<double>(opts.stop - opts.start) * period);
+      fst_->close();
+    }
+  }
+
+  UUT & uut_;
+  std::unique_ptr<VerilatedFstSc> fst_;
+};
+
+#else
+
+template <typename UUT>
+class Trace {
+ public:
+  Trace(const char *, UUT &) {
+    if (!trace_options().file.empty())
+      trace_unavailable();
+  }
+};
+
+#endif
+
+} // namespace libtbx
+
+#endif
@@ -0,0 +1,168 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_TXLOG_H
+#define LIBTBX_TXLOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// Binary, append-only transaction log. The log is a header followed by a
+// sequence of fixed-size records, each recording the time (in clock cycles)
+// at which a transaction was observed, the interface upon which it was
+// observed and up to TX_FIELDS_N words of payload. Interfaces are declared
+// in-band upon their first transaction such that logs remain self-describing;
+// a declaration record is followed by its descriptor text,
+//
+//   <name>:<field>,<field>,...
+//
+// padded to a whole number of records. Logs are rendered by the txlog_decode
+// tool.
+//
+namespace libtbx {
+
+constexpr char TX_MAGIC[8] = {'L', 'I', 'B', 'T', 'B', 'X', 'T', 'X'};
+constexpr std::uint32_t TX_VERSION = 1;
+constexpr std::size_t TX_FIELDS_N = 4;
+
+// Interface identifier reserved for declaration records.
+//
+constexpr std::uint32_t TX_DECLARE = 0;
+
+// Record flags.
+//
+constexpr std::uint32_t TX_FLAG_ERROR = 0x1;
+
+struct TxHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t record_size;
+};
+
+struct TxRecord {
+  std::uint64_t time;
+  // Interface identifier, or TX_DECLARE.
+  std::uint32_t iface;
+  // For declarations, the identifier being declared; otherwise TX_FLAG_*.
+  std::uint32_t flags;
+  // For declarations, data[0] is the length of the descriptor text.
+  std::uint64_t data[TX_FIELDS_N];
+};
+
+static_assert(sizeof(TxRecord) == 48, "TxRecord is not packed");
+
+class TxLog {
+ public:
+  static TxLog & get();
+
+  ~TxLog();
+
+  // Open FN for writing. Logging is disabled until opened.
+  //
+  bool open(const std::string & fn);
+  void close();
+  bool enabled() const { return f_ != nullptr; }
+
+  // Source of the current time, in cycles.
+  //
+  void set_time(std::uint64_t (*f)()) { time_ = f; }
+
+  std::uint32_t declare(const std::string & descriptor);
+
+  void append(std::uint32_t iface, std::uint32_t flags,
+              std::uint64_t a, std::uint64_t b,
+              std::uint64_t c, std::uint64_t d) {
+    if (n_ == buf_.size())
+      flush();
+    TxRecord & r = buf_[n_++];
+    r.time = time_ ? time_() : 0;
+    r.iface = iface;
+    r.flags = flags;
+    r.data[0] = a;
+    r.data[1] = b;
+    r.data[2] = c;
+    r.data[3] = d;
+  }
+
+  void flush();
+
+ private:
+  TxLog();
+
+  std::FILE * f_{nullptr};
+  std::vector<TxRecord> buf_;
+  std::size_t n_{0};
+  std::uint32_t next_id_{TX_DECLARE + 1};
+  std::uint64_t (*time_)(){nullptr};
+};
+
+// A named interface with up to TX_FIELDS_N named payload fields. Recording is
+// a single test when logging is disabled.
+//
+//   TxInterface tx_upt_{"upt", {"id", "op", "key", "size"}};
+//   ...
+//   tx_upt_.record(id, op, k, s);
+//
+class TxInterface {
+ public:
+  TxInterface(const char * name, std::initializer_list<const char *> fields);
+
+  void record(std::uint64_t a = 0, std::uint64_t b = 0,
+              std::uint64_t c = 0, std::uint64_t d = 0) {
+    record_flags(0, a, b, c, d);
+  }
+
+  // As record, but with the record marked as erroneous (for example, a
+  // mismatch detected by a checker).
+  //
+  void record_error(std::uint64_t a = 0, std::uint64_t b = 0,
+                    std::uint64_t c = 0, std::uint64_t d = 0) {
+    record_flags(TX_FLAG_ERROR, a, b, c, d);
+  }
+
+ private:
+  void record_flags(std::uint32_t flags,
+                    std::uint64_t a, std::uint64_t b,
+                    std::uint64_t c, std::uint64_t d) {
+    TxLog & log = TxLog::get();
+    if (!log.enabled())
+      return;
+    if (id_ == TX_DECLARE)
+      id_ = log.declare(descriptor_);
+    log.append(id_, flags, a, b, c, d);
+  }
+
+  std::string descriptor_;
+  std::uint32_t id_{TX_DECLARE};
+};
+
+} // namespace libtbx
+
+#endif
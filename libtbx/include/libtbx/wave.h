@@ -0,0 +1,155 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef LIBTBX_WAVE_H
+#define LIBTBX_WAVE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if VM_TRACE
+#  include <gtkwave/fstapi.h>
+#endif
+
+// In-memory waveform capture. The values of a set of probed signals are
+// sampled once per cycle into a ring of the most recent wave_ring_cycles
+// cycles; upon the first error reported, the ring is written to the file named
+// by the knob 'wave_ring'. Nothing is written by passing runs.
+//
+//   ./sorted_lists +wave_ring=fail.fst +wave_ring_cycles=10000
+//
+// The window is written as FST by models linked against the Verilator FST
+// writer (traced models); otherwise, it is written as VCD (to <file>.vcd).
+// Probed signals are at most 64 bits wide.
+//
+namespace libtbx {
+
+class WaveRing {
+ public:
+  using writer_type = bool (*)(const WaveRing &, const std::string &);
+
+  WaveRing();
+  ~WaveRing();
+
+  // Probe signal S (sc_signal<T> or libtbx::Signal<T>) as NAME.
+  //
+  template <typename S>
+  void probe(const std::string & name, const S & s) {
+    using T = typename std::decay<decltype(s.read())>::type;
+    const unsigned bits =
+        std::is_same<T, bool>::value ? 1 : (8 * sizeof(T));
+    probe(name, bits, [&s]() { return static_cast<std::uint64_t>(s.read()); });
+  }
+
+  void probe(const std::string & name, unsigned bits,
+             std::function<std::uint64_t()> f);
+
+  // Sample each probe; called once per cycle.
+  //
+  void sample() {
+    if (depth_ != 0)
+      sample_all();
+  }
+
+  // Write the captured window to FN; invoked upon the first error.
+  //
+  void flush(const std::string & fn) const;
+
+  // Accessors for writers.
+  //
+  std::size_t probes() const { return names_.size(); }
+  const std::string & name(std::size_t i) const { return names_[i]; }
+  unsigned bits(std::size_t i) const { return bits_[i]; }
+  // Number of cycles captured, and the cycle of the oldest.
+  std::size_t cycles() const;
+  std::uint64_t first_cycle() const;
+  // Value of probe P at the I'th captured cycle (oldest first).
+  std::uint64_t value(std::size_t i, std::size_t p) const;
+
+  // Install the writer used in place of the VCD writer.
+  //
+  static void set_writer(writer_type w, const char * suffix);
+
+ private:
+  void sample_all();
+
+  std::size_t depth_;
+  std::uint64_t n_{0};
+  std::vector<std::string> names_;
+  std::vector<unsigned> bits_;
+  std::vector<std::function<std::uint64_t()>> fs_;
+  std::vector<std::uint64_t> ring_;
+};
+
+#if VM_TRACE
+
+inline bool write_wave_fst(const WaveRing & r, const std::string & fn) {
+  void * ctx = fstWriterCreate(fn.c_str(), 1);
+  if (ctx == nullptr)
+    return false;
+  fstWriterSetTimescale(ctx, -9);
+  fstWriterSetScope(ctx, FST_ST_VCD_MODULE, "tb", nullptr);
+  std::vector<fstHandle> hs;
+  for (std::size_t p = 0; p < r.probes(); p++)
+    hs.push_back(fstWriterCreateVar(ctx, FST_VT_VCD_WIRE, FST_VD_IMPLICIT,
+                                    r.bits(p), r.name(p).c_str(), 0));
+  fstWriterSetUpscope(ctx);
+
+  std::string v;
+  for (std::size_t i = 0; i < r.cycles(); i++) {
+    fstWriterEmitTimeChange(ctx, r.first_cycle() + i);
+    for (std::size_t p = 0; p < r.probes(); p++) {
+      const std::uint64_t x = r.value(i, p);
+      if (i != 0 && x == r.value(i - 1, p))
+        continue;
+      v.assign(r.bits(p), '0');
+      for (unsigned b = 0; b < r.bits(p); b++)
+        if ((x >> b) & 1)
+          v[r.bits(p) - 1 - b] = '1';
+      fstWriterEmitValueChange(ctx, hs[p], v.c_str());
+    }
+  }
+  fstWriterClose(ctx);
+  return true;
+}
+
+namespace {
+
+struct WaveFstRegistrar {
+  WaveFstRegistrar() { WaveRing::set_writer(&write_wave_fst, ""); }
+} wave_fst_registrar_;
+
+} // namespace
+
+#endif
+
+} // namespace libtbx
+
+#endif
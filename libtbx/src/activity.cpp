@@ -0,0 +1,236 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/activity.h>
+#include <libtbx/knob.h>
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+libtbx::Knob<std::string> saif_{
+  "saif", "", "Export switching activity to the named SAIF file"};
+libtbx::Knob<std::size_t> activity_top_{
+  "activity_top", 8, "Most active signals reported"};
+
+// A scope of the design hierarchy: the toggle count of each bit of each of its
+// signals, and its child scopes.
+//
+struct Scope {
+  std::map<std::string, std::uint64_t> nets;
+  std::map<std::string, Scope> scopes;
+};
+
+// Each record of a VerilatedCov database is a line of the form:
+//
+//   C '<\001key\002value...>' count
+//
+// Return the value of KEY within the record, or the empty string.
+//
+std::string field(const std::string & rec, const std::string & key) {
+  const std::string tag = "\001" + key + "\002";
+  const std::size_t b = rec.find(tag);
+  if (b == std::string::npos)
+    return "";
+  const std::size_t v = b + tag.size();
+  return rec.substr(v, rec.find('\001', v) - v);
+}
+
+// Strip the bit (and array) indices from NET, yielding its signal.
+//
+std::string signal_of(const std::string & net) {
+  return net.substr(0, net.find('['));
+}
+
+// SAIF identifiers escape the bus and array delimiters.
+//
+std::string saif_escape(const std::string & name) {
+  std::string s;
+  for (char c : name) {
+    if (c == '[' || c == ']' || c == '.' || c == '/')
+      s += '\\';
+    s += c;
+  }
+  return s;
+}
+
+void write_scope(std::ostream & os, const std::string & name,
+                 const Scope & scope, int depth) {
+  const std::string indent(2 * depth, ' ');
+  os << indent << "(INSTANCE " << saif_escape(name) << "\n";
+  if (!scope.nets.empty()) {
+    os << indent << "  (NET\n";
+    for (const std::pair<const std::string, std::uint64_t> & net : scope.nets)
+      os << indent << "    (" << saif_escape(net.first)
+         << " (TC " << net.second << "))\n";
+    os << indent << "  )\n";
+  }
+  for (const std::pair<const std::string, Scope> & s : scope.scopes)
+    write_scope(os, s.first, s.second, depth + 1);
+  os << indent << ")\n";
+}
+
+bool write_saif(const std::string & file, const Scope & root, double cycles) {
+  std::ofstream os{file};
+  if (!os)
+    return false;
+
+  char date[64];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%c", std::localtime(&now));
+
+  os << "(SAIFILE\n"
+     << "(SAIFVERSION \"2.0\")\n"
+     << "(DIRECTION \"backward\")\n"
+     << "(DESIGN )\n"
+     << "(DATE \"" << date << "\")\n"
+     << "(VENDOR \"hw_interview_questions\")\n"
+     << "(PROGRAM_NAME \"libtbx\")\n"
+     << "(VERSION \"1.0\")\n"
+     << "(DIVIDER . )\n"
+     << "(TIMESCALE 1 ns)\n"
+     << std::fixed << std::setprecision(0)
+     << "(DURATION " << cycles << ")\n";
+  for (const std::pair<const std::string, Scope> & s : root.scopes)
+    write_scope(os, s.first, s.second, 0);
+  os << ")\n";
+  return static_cast<bool>(os);
+}
+
+} // namespace
+
+namespace libtbx {
+
+const ActivityOptions & activity_options() {
+  static ActivityOptions opts;
+  static bool init = false;
+  if (!init) {
+    opts.saif = saif_;
+    opts.top = activity_top_;
+    init = true;
+  }
+  return opts;
+}
+
+void report_activity(const std::string & file, double cycles) {
+  const ActivityOptions & opts = activity_options();
+
+  std::ifstream is{file};
+  if (!is) {
+    std::cerr << "[libtbx] activity: cannot read " << file << "\n";
+    return;
+  }
+
+  // Newer releases of Verilator count the rising and falling transitions of
+  // each bit separately (as "<net>:0->1" and "<net>:1->0"); both are folded
+  // into the toggle count of the bit.
+  //
+  Scope root;
+  std::map<std::string, std::uint64_t> signals;
+  std::uint64_t toggles = 0;
+  std::size_t nets = 0;
+  std::string line;
+  while (std::getline(is, line)) {
+    const std::size_t b = line.find('\'');
+    const std::size_t e = line.rfind('\'');
+    if (line.compare(0, 2, "C ") != 0 || b == e)
+      continue;
+    const std::string rec = line.substr(b + 1, e - b - 1);
+    if (field(rec, "page").compare(0, 8, "v_toggle") != 0)
+      continue;
+
+    std::string net = field(rec, "o");
+    net = net.substr(0, net.find(':'));
+    const std::uint64_t count = std::stoull(line.substr(e + 1));
+
+    Scope * scope = &root;
+    std::string hier = field(rec, "h");
+    std::size_t pos = 0;
+    while (!hier.empty()) {
+      const std::size_t dot = hier.find('.', pos);
+      scope = &scope->scopes[hier.substr(pos, dot - pos)];
+      if (dot == std::string::npos)
+        break;
+      pos = dot + 1;
+    }
+    std::map<std::string, std::uint64_t>::iterator it = scope->nets.find(net);
+    if (it == scope->nets.end()) {
+      it = scope->nets.emplace(net, 0).first;
+      ++nets;
+    }
+    it->second += count;
+    toggles += count;
+    signals[hier.empty() ? signal_of(net) : hier + "." + signal_of(net)] +=
+        count;
+  }
+
+  const double per_cycle = (cycles > 0) ? (toggles / cycles) : 0;
+  const std::ios::fmtflags flags = std::cout.flags();
+  const std::streamsize precision = std::cout.precision();
+  std::cout << "[libtbx] activity"
+            << " toggles=" << toggles
+            << " nets=" << nets
+            << std::fixed << std::setprecision(0)
+            << " cycles=" << cycles
+            << std::setprecision(3)
+            << " toggles_per_cycle=" << per_cycle
+            << "\n";
+
+  std::vector<std::pair<std::string, std::uint64_t>> top{
+    signals.begin(), signals.end()};
+  std::stable_sort(top.begin(), top.end(),
+                   [](const std::pair<std::string, std::uint64_t> & a,
+                      const std::pair<std::string, std::uint64_t> & b) {
+                     return a.second > b.second;
+                   });
+  top.resize(std::min(top.size(), opts.top));
+  for (const std::pair<std::string, std::uint64_t> & s : top)
+    std::cout << "[libtbx] activity signal=" << s.first
+              << " toggles=" << s.second
+              << std::setprecision(3)
+              << " per_cycle=" << ((cycles > 0) ? (s.second / cycles) : 0)
+              << "\n";
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+
+  if (!opts.saif.empty() && !write_saif(opts.saif, root, cycles))
+    std::cerr << "[libtbx] activity: cannot write " << opts.saif << "\n";
+}
+
+void activity_unavailable() {
+  std::cerr << "[libtbx] activity requested of a model which is not "
+            << "instrumented; run the <answer>_activity model\n";
+}
+
+} // namespace libtbx
@@ -0,0 +1,156 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/coverage.h>
+#include <libtbx/knob.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+libtbx::Knob<bool> coverage_stop_{
+  "coverage_stop", false, "End random tests once all coverage is closed"};
+libtbx::Knob<std::size_t> coverage_holes_{
+  "coverage_holes", 8, "Uncovered bins reported per coverpoint or cross"};
+
+std::vector<libtbx::Coverage *> & coverage() {
+  static std::vector<libtbx::Coverage *> v;
+  return v;
+}
+
+// Number of live coverpoints and crosses not yet closed.
+//
+std::size_t open_{0};
+
+std::size_t product(std::initializer_list<libtbx::Coverpoint *> ps) {
+  std::size_t n = 1;
+  for (const libtbx::Coverpoint * cp : ps)
+    n *= cp->bins();
+  return n;
+}
+
+double pct(std::size_t covered, std::size_t bins) {
+  return (bins != 0) ? (100.0 * covered / bins) : 100.0;
+}
+
+} // namespace
+
+namespace libtbx {
+
+Coverage::Coverage(const char * name, std::size_t bins, std::uint64_t goal)
+    : name_(name), goal_(std::max<std::uint64_t>(goal, 1)), counts_(bins) {
+  coverage().push_back(this);
+  if (!closed())
+    ++open_;
+}
+
+Coverage::~Coverage() {
+  std::vector<Coverage *> & v = coverage();
+  v.erase(std::remove(v.begin(), v.end(), this), v.end());
+  if (!closed())
+    --open_;
+}
+
+void Coverage::cover() {
+  if (++covered_ == counts_.size())
+    --open_;
+}
+
+Coverpoint::Coverpoint(const char * name, std::vector<std::string> bins,
+                       std::uint64_t goal)
+    : Coverage(name, bins.size(), goal), bins_(std::move(bins)) {}
+
+Cross::Cross(const char * name,
+             std::initializer_list<Coverpoint *> points,
+             std::uint64_t goal)
+    : Coverage(name, product(points), goal),
+      points_(points), strides_(points.size()) {
+  std::size_t stride = 1;
+  for (std::size_t i = points_.size(); i-- != 0;) {
+    strides_[i] = stride;
+    stride *= points_[i]->bins();
+  }
+}
+
+std::string Cross::bin_name(std::size_t bin) const {
+  std::stringstream ss;
+  for (std::size_t i = 0; i < points_.size(); i++) {
+    if (i != 0)
+      ss << ",";
+    ss << points_[i]->name() << "="
+       << points_[i]->bin_name(bin / strides_[i]);
+    bin %= strides_[i];
+  }
+  return ss.str();
+}
+
+bool coverage_done() {
+  return (open_ == 0) && !coverage().empty() && coverage_stop_;
+}
+
+void report_coverage() {
+  if (coverage().empty())
+    return;
+
+  const std::ios_base::fmtflags flags = std::cout.flags();
+  const std::streamsize precision = std::cout.precision();
+  std::cout << std::fixed << std::setprecision(1);
+
+  std::size_t bins = 0;
+  std::size_t covered = 0;
+  for (const Coverage * c : coverage()) {
+    std::cout << "[libtbx] coverage=" << c->name()
+              << " covered=" << c->covered()
+              << " bins=" << c->bins()
+              << " pct=" << pct(c->covered(), c->bins())
+              << " samples=" << c->samples()
+              << "\n";
+    std::size_t holes = coverage_holes_;
+    for (std::size_t bin = 0; (bin < c->bins()) && (holes != 0); bin++) {
+      if (c->count(bin) >= c->goal())
+        continue;
+      std::cout << "[libtbx] coverage=" << c->name()
+                << " hole=" << c->bin_name(bin) << "\n";
+      --holes;
+    }
+    bins += c->bins();
+    covered += c->covered();
+  }
+  std::cout << "[libtbx] coverage"
+            << " covered=" << covered
+            << " bins=" << bins
+            << " pct=" << pct(covered, bins)
+            << " closed=" << std::boolalpha << (open_ == 0)
+            << "\n";
+
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
+
+} // namespace libtbx
@@ -0,0 +1,181 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/edges.h>
+#include <libtbx/knob.h>
+#include <libtbx/sim.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+libtbx::Knob<std::size_t> edges_depth_{
+  "edges_depth", 16, "Edges retained per monitor, reported upon a violation"};
+
+std::vector<libtbx::EdgeRecorder *> & recorders() {
+  static std::vector<libtbx::EdgeRecorder *> v;
+  return v;
+}
+
+std::uint64_t distance(std::uint64_t a, std::uint64_t b) {
+  return (a > b) ? (a - b) : (b - a);
+}
+
+} // namespace
+
+namespace libtbx {
+
+EdgeRecorder::EdgeRecorder(const std::string & name, const ClockSpec & spec)
+    : name_(name), spec_(spec), ring_(std::max<std::size_t>(edges_depth_, 1)) {
+  static bool registered = false;
+  if (!registered) {
+    on_complete([](double) {
+        for (const EdgeRecorder * r : recorders())
+          r->report();
+      });
+    registered = true;
+  }
+  recorders().push_back(this);
+}
+
+EdgeRecorder::~EdgeRecorder() {
+  std::vector<EdgeRecorder *> & v = recorders();
+  v.erase(std::remove(v.begin(), v.end(), this), v.end());
+}
+
+void EdgeRecorder::edge(std::uint64_t t, bool level) {
+  ring_[head_] = (t << 1) | (level ? 1 : 0);
+  head_ = (head_ + 1) % ring_.size();
+  ++edges_;
+
+  if (!level) {
+    fall_ = t;
+    fell_ = true;
+    return;
+  }
+
+  // A period is complete upon each rising edge, that preceding it having been
+  // followed by a falling edge.
+  //
+  if (rose_ && fell_ && (fall_ > rise_)) {
+    if (settled_ < spec_.settle)
+      ++settled_;
+    else
+      check(t - rise_, fall_ - rise_);
+  }
+  rise_ = t;
+  rose_ = true;
+}
+
+void EdgeRecorder::check(std::uint64_t period, std::uint64_t high) {
+  const double tolerance = spec_.tolerance * ticks_per_cycle_;
+  const double expected_period = spec_.period * ticks_per_cycle_;
+  const double expected_high = spec_.duty * expected_period;
+
+  if (std::fabs(period - expected_period) > tolerance) {
+    std::ostringstream ss;
+    ss << "period " << cycles(period) << " (expected " << spec_.period << ")";
+    violation(ss.str());
+  }
+  if (std::fabs(high - expected_high) > tolerance) {
+    std::ostringstream ss;
+    ss << "high time " << cycles(high)
+       << " (expected " << cycles(expected_high) << ")";
+    violation(ss.str());
+  }
+
+  const double duty = static_cast<double>(high) / period;
+  if (n_ == 0) {
+    period_min_ = period_max_ = period;
+    duty_min_ = duty_max_ = duty;
+  } else {
+    period_min_ = std::min(period_min_, period);
+    period_max_ = std::max(period_max_, period);
+    duty_min_ = std::min(duty_min_, duty);
+    duty_max_ = std::max(duty_max_, duty);
+    c2c_max_ = std::max(c2c_max_, distance(period, last_period_));
+  }
+  ++n_;
+  const double delta = period - period_mean_;
+  period_mean_ += delta / n_;
+  period_m2_ += delta * (period - period_mean_);
+  duty_mean_ += (duty - duty_mean_) / n_;
+  last_period_ = period;
+}
+
+void EdgeRecorder::violation(const std::string & what) {
+  if (violations_++ != 0)
+    return;
+
+  // Report the first violation alone, with the edges which preceded it (the
+  // oldest first), as subsequent violations are typically its consequence.
+  //
+  std::ostringstream ss;
+  ss << name_ << ": " << what << "; last edges (cycle:level):";
+  const std::size_t n = std::min<std::uint64_t>(edges_, ring_.size());
+  for (std::size_t i = 0; i < n; i++) {
+    const std::uint64_t e = ring_[(head_ + ring_.size() - n + i) % ring_.size()];
+    ss << " " << cycles(e >> 1) << ":" << (e & 1);
+  }
+  LIBTB_REPORT_ERROR(ss.str());
+}
+
+void EdgeRecorder::expect_periods(std::uint64_t n) const {
+  if (n_ < n) {
+    std::ostringstream ss;
+    ss << name_ << ": " << n_ << " periods checked (expected " << n << ")";
+    LIBTB_REPORT_ERROR(ss.str());
+  }
+}
+
+void EdgeRecorder::report() const {
+  const double rms = (n_ != 0) ? std::sqrt(period_m2_ / n_) : 0;
+  const std::ios::fmtflags flags = std::cout.flags();
+  const std::streamsize precision = std::cout.precision();
+  std::cout << "[libtbx] edges=" << name_
+            << " transitions=" << edges_
+            << " periods=" << n_
+            << std::fixed << std::setprecision(3)
+            << " period=" << cycles(period_mean_)
+            << " period_min=" << cycles(period_min_)
+            << " period_max=" << cycles(period_max_)
+            << " duty=" << duty_mean_
+            << " duty_min=" << duty_min_
+            << " duty_max=" << duty_max_
+            << " jitter_pp=" << cycles(period_max_ - period_min_)
+            << " jitter_rms=" << cycles(rms)
+            << " jitter_c2c=" << cycles(c2c_max_)
+            << " violations=" << violations_
+            << "\n";
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
+
+} // namespace libtbx
@@ -0,0 +1,89 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/explore.h>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+libtbx::Knob<std::size_t> explore_depth_{
+  "explore_depth", 64, "Maximum depth, in cycles from reset, explored"};
+libtbx::Knob<std::size_t> explore_states_{
+  "explore_states", std::size_t{1} << 20, "Maximum number of states retained"};
+
+} // namespace
+
+namespace libtbx {
+
+const ExploreOptions & explore_options() {
+  static const ExploreOptions opts{explore_depth_, explore_states_};
+  return opts;
+}
+
+std::uint64_t explore_hash(const std::uint8_t * p, std::size_t len,
+                           std::uint64_t seed) {
+  std::uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+  for (std::size_t i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+int report_explore(const std::string & why, const std::vector<std::size_t> & path,
+                   const std::vector<std::string> & choices,
+                   std::uint64_t states, std::uint64_t transitions,
+                   std::size_t depth, bool complete, double wall_s) {
+  if (!why.empty()) {
+    std::cout << "[libtbx] explore fail " << why << "\n"
+              << "[libtbx] explore counterexample (from reset):";
+    for (std::size_t c : path)
+      std::cout << " " << choices[c];
+    std::cout << "\n";
+  }
+
+  const double rate = (wall_s > 0) ? (transitions / wall_s) : 0;
+  const std::ios_base::fmtflags flags = std::cout.flags();
+  const std::streamsize precision = std::cout.precision();
+  std::cout << "[libtbx] explore"
+            << " states=" << states
+            << " transitions=" << transitions
+            << " depth=" << depth
+            << " complete=" << (complete ? 1 : 0)
+            << " failed=" << (why.empty() ? 0 : 1)
+            << std::fixed << std::setprecision(6)
+            << " wall_s=" << wall_s
+            << std::setprecision(0)
+            << " transitions_per_s=" << rate
+            << "\n";
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+  return why.empty() ? 0 : 1;
+}
+
+} // namespace libtbx
@@ -0,0 +1,142 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/knob.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace {
+
+std::vector<libtbx::KnobBase *> & knobs() {
+  static std::vector<libtbx::KnobBase *> k;
+  return k;
+}
+
+std::map<std::string, std::string> & overrides() {
+  static std::map<std::string, std::string> o;
+  return o;
+}
+
+// Record an override of the form '<name>=<value>'; returns false otherwise.
+//
+bool add_override(const std::string & s) {
+  const std::size_t eq = s.find('=');
+  if (eq == std::string::npos || eq == 0)
+    return false;
+  overrides()[s.substr(0, eq)] = s.substr(eq + 1);
+  return true;
+}
+
+} // namespace
+
+namespace libtbx {
+
+KnobBase::KnobBase(const char * name, const char * description)
+    : name_(name), description_(description) {
+  knobs().push_back(this);
+}
+
+KnobBase::~KnobBase() {
+  std::vector<KnobBase *> & k = knobs();
+  k.erase(std::remove(k.begin(), k.end(), this), k.end());
+}
+
+const std::string * KnobBase::find_override() const {
+  const auto it = overrides().find(name_);
+  return (it != overrides().end()) ? &it->second : nullptr;
+}
+
+bool parse_knob(const std::string & s, bool & t) {
+  if (s == "1" || s == "true") {
+    t = true;
+  } else if (s == "0" || s == "false") {
+    t = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool parse_knob(const std::string & s, std::string & t) {
+  t = s;
+  return true;
+}
+
+int parse_knobs(int argc, char ** argv) {
+  // Environment first, such that the command line takes precedence. Overrides
+  // are separated by whitespace only, as a value may itself be a list
+  // (tests=test_1,test_0).
+  if (const char * env = std::getenv("LIBTBX_KNOBS")) {
+    std::istringstream ss{env};
+    std::string kv;
+    while (ss >> kv) {
+      if (!add_override(kv))
+        std::cerr << "[libtbx] ignoring malformed knob '" << kv << "'\n";
+    }
+  }
+
+  int n = 1;
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] == '+' && add_override(argv[i] + 1))
+      continue;
+    argv[n++] = argv[i];
+  }
+  if (n < argc)
+    argv[n] = nullptr;
+  return n;
+}
+
+bool report_knobs() {
+  bool ok = true;
+  std::set<std::string> names;
+  for (const KnobBase * k : knobs()) {
+    if (!names.insert(k->name()).second)
+      continue;
+    std::cout << "[libtbx] knob " << k->name() << "=" << k->value();
+    if (k->overridden())
+      std::cout << " (default " << k->default_value() << ")";
+    std::cout << "\n";
+    if (!k->valid()) {
+      std::cerr << "[libtbx] invalid value for knob '" << k->name() << "': "
+                << *k->find_override() << "\n";
+      ok = false;
+    }
+  }
+  for (const auto & o : overrides()) {
+    if (names.count(o.first) == 0) {
+      std::cerr << "[libtbx] unknown knob '" << o.first << "'\n";
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+} // namespace libtbx
@@ -0,0 +1,271 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+// Context switches between testbench threads occur at least once per thread
+// per cycle and are implemented with _setjmp/_longjmp rather than swapcontext
+// (which incurs a system call to save the signal mask). The fortified
+// longjmp rejects jumps between stacks, therefore this source is compiled
+// with -U_FORTIFY_SOURCE (see libtbx/CMakeLists.txt).
+//
+#include <libtbx/coverage.h>
+#include <libtbx/knob.h>
+#include <libtbx/native.h>
+#include <libtbx/profile.h>
+#include <libtbx/scoreboard.h>
+#include <libtbx/sim.h>
+#include <libtbx/txlog.h>
+#include <ucontext.h>
+#include <algorithm>
+#include <csetjmp>
+#include <chrono>
+#include <exception>
+#include <memory>
+
+namespace libtbx {
+namespace native {
+
+namespace {
+
+TopLevel * top_{nullptr};
+
+} // namespace
+
+// A cooperative thread. The thread is created with makecontext, upon which
+// it immediately returns to its creator; thereafter it is resumed with
+// _longjmp.
+//
+class Process {
+ public:
+  static constexpr std::size_t STACK_SIZE = 1 << 20;
+
+  Process(std::function<void()> f) : f_(f), stack_(new char[STACK_SIZE]) {
+    ucontext_t uc;
+    ::getcontext(&uc);
+    uc.uc_stack.ss_sp = stack_.get();
+    uc.uc_stack.ss_size = STACK_SIZE;
+    uc.uc_link = nullptr;
+    const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(this);
+    ::makecontext(&uc, reinterpret_cast<void (*)()>(&Process::entry), 2,
+                  static_cast<unsigned>(p >> 32),
+                  static_cast<unsigned>(p & 0xFFFFFFFFu));
+    ::swapcontext(&creator_, &uc);
+  }
+
+  // Transfer control to the process until it next yields.
+  //
+  void resume() {
+    if (!_setjmp(caller_))
+      _longjmp(ctx_, 1);
+    if (exception_)
+      std::rethrow_exception(exception_);
+  }
+
+  // Return control to the scheduler.
+  //
+  void yield() {
+    if (!_setjmp(ctx_))
+      _longjmp(caller_, 1);
+  }
+
+  bool done() const { return done_; }
+
+  // The cycle at which the process is to be resumed, or zero if the process
+  // is blocked upon an event.
+  //
+  std::uint64_t wake_{0};
+
+ private:
+  static void entry(unsigned hi, unsigned lo) {
+    Process * p = reinterpret_cast<Process *>(
+        (static_cast<std::uintptr_t>(hi) << 32) | lo);
+    if (!_setjmp(p->ctx_))
+      ::setcontext(&p->creator_);
+    try {
+      p->f_();
+    } catch (...) {
+      p->exception_ = std::current_exception();
+    }
+    p->done_ = true;
+    _longjmp(p->caller_, 1);
+  }
+
+  std::function<void()> f_;
+  std::unique_ptr<char[]> stack_;
+  ucontext_t creator_;
+  std::jmp_buf ctx_;
+  std::jmp_buf caller_;
+  std::exception_ptr exception_;
+  bool done_{false};
+};
+
+void Event::notify() {
+  for (Process * p : waiters_)
+    p->wake_ = 1;
+  waiters_.clear();
+}
+
+TopLevel::TopLevel(const char *) {
+  top_ = this;
+}
+
+TopLevel::~TopLevel() {
+  for (Process * p : procs_)
+    delete p;
+  top_ = nullptr;
+}
+
+void TopLevel::t_wait_reset_done() {
+  if (!reset_done_)
+    wait(e_reset_done_);
+}
+
+void TopLevel::t_wait_posedge_clk(int n) {
+  current_->wake_ = cycle_ + n;
+  yield();
+}
+
+void TopLevel::wait(Event & e) {
+  current_->wake_ = 0;
+  e.waiters_.push_back(current_);
+  yield();
+}
+
+void TopLevel::spawn(std::function<void()> f) {
+  procs_.push_back(new Process(f));
+}
+
+void TopLevel::on_posedge(std::function<void()> f) {
+  posedges_.push_back(f);
+}
+
+void TopLevel::on_sample(std::function<void()> f) {
+  samplers_.push_back(f);
+}
+
+void TopLevel::yield() {
+  Process * p = current_;
+  p->yield();
+  current_ = p;
+}
+
+// Resume, in order of creation, each thread due at the current cycle. A
+// thread woken by an event notified by another thread in this cycle is itself
+// resumed within the same cycle.
+//
+void TopLevel::schedule() {
+  auto due = [this](const Process * p) {
+    return !p->done() && (p->wake_ != 0) && (p->wake_ <= cycle_);
+  };
+  bool again = true;
+  while (again) {
+    for (Process * p : procs_) {
+      if (!due(p))
+        continue;
+      p->wake_ = 0;
+      current_ = p;
+      p->resume();
+      current_ = nullptr;
+    }
+    again = std::any_of(procs_.begin(), procs_.end(), due);
+  }
+}
+
+void TopLevel::eval() {
+  LIBTBX_PROFILE_SCOPE("eval");
+  eval_(uut_);
+}
+
+void TopLevel::simulate() {
+  bool finished = false;
+  spawn([&]() {
+      run_test();
+      finished = true;
+    });
+  for (Process * p : procs_)
+    p->wake_ = 1;
+
+  *rst_ = 1;
+  *clk_ = 0;
+  eval();
+  while (!finished) {
+    *clk_ = 1;
+    eval();
+    ++cycle_;
+
+    if (cycle_ == RESET_CYCLES) {
+      *rst_ = 0;
+      reset_done_ = true;
+      e_reset_done_.notify();
+    }
+    for (const std::function<void()> & f : posedges_)
+      f();
+    schedule();
+    eval();
+    for (const std::function<void()> & f : samplers_)
+      f();
+
+    *clk_ = 0;
+    eval();
+  }
+  final_(uut_);
+}
+
+int start() {
+  using clock_type = std::chrono::steady_clock;
+
+  if (!report_knobs())
+    return 1;
+
+  TxLog::get().set_time([]() -> std::uint64_t { return top_->cycle(); });
+
+  profile_begin();
+  const clock_type::time_point t0 = clock_type::now();
+  top_->simulate();
+  const std::chrono::duration<double> wall = clock_type::now() - t0;
+  TxLog::get().close();
+  report_scoreboards();
+  report_coverage();
+  complete(top_->cycle());
+  profile_report(top_->cycle(), wall.count());
+  report(top_->cycle(), wall.count());
+
+  const int errors =
+      sc_core::sc_report_handler::get_count(sc_core::SC_ERROR) +
+      sc_core::sc_report_handler::get_count(sc_core::SC_FATAL);
+  return (errors != 0) ? 1 : 0;
+}
+
+} // namespace native
+} // namespace libtbx
+
+// Verilator models reference the current simulation time through
+// sc_time_stamp() when not verilated against SystemC.
+//
+double sc_time_stamp() {
+  const libtbx::native::TopLevel * top = libtbx::native::top_;
+  return top ? static_cast<double>(top->cycle()) : 0;
+}
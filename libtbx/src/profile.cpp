@@ -0,0 +1,116 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/knob.h>
+#include <libtbx/profile.h>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+libtbx::Knob<bool> profile_knob_{
+  "profile", false, "Report a wall-time breakdown of the simulation"};
+
+std::vector<libtbx::ProfileZone *> & zones() {
+  static std::vector<libtbx::ProfileZone *> z;
+  return z;
+}
+
+libtbx::ProfileZone kernel_{"kernel"};
+
+} // namespace
+
+namespace libtbx {
+
+bool profile_enabled{false};
+ProfileZone * profile_current{&kernel_};
+std::uint64_t profile_last{0};
+
+ProfileZone::ProfileZone(const char * name) : name_(name) {
+  zones().push_back(this);
+}
+
+void profile_begin() {
+  profile_enabled = profile_knob_;
+  profile_current = &kernel_;
+  profile_last = profile_ticks();
+}
+
+void profile_report(double cycles, double wall_s) {
+  if (!profile_enabled)
+    return;
+  profile_current->ticks += (profile_ticks() - profile_last);
+  profile_enabled = false;
+
+  // Zones of the same name (at distinct sites) are reported together.
+  //
+  struct Entry {
+    const char * name;
+    std::uint64_t ticks;
+    std::uint64_t calls;
+  };
+  std::vector<Entry> es;
+  std::uint64_t total = 0;
+  for (const ProfileZone * z : zones()) {
+    total += z->ticks;
+    bool found = false;
+    for (Entry & e : es) {
+      if (std::strcmp(e.name, z->name()) == 0) {
+        e.ticks += z->ticks;
+        e.calls += z->calls;
+        found = true;
+      }
+    }
+    if (!found)
+      es.push_back(Entry{z->name(), z->ticks, z->calls});
+  }
+  if (total == 0)
+    return;
+
+  const std::ios::fmtflags flags = std::cout.flags();
+  const std::streamsize precision = std::cout.precision();
+  for (const Entry & e : es) {
+    const double f = static_cast<double>(e.ticks) / total;
+    const double s = f * wall_s;
+    std::cout << "[libtbx] profile zone=" << e.name
+              << std::fixed << std::setprecision(1)
+              << " pct=" << (100 * f)
+              << std::setprecision(6)
+              << " s=" << s
+              << " calls=" << e.calls
+              << std::setprecision(1)
+              << " ns_per_call=" << ((e.calls != 0) ? (1e9 * s / e.calls) : 0)
+              << " ns_per_cycle=" << ((cycles > 0) ? (1e9 * s / cycles) : 0)
+              << "\n";
+  }
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
+
+} // namespace libtbx
@@ -0,0 +1,106 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtb.h>
+#include <libtbx/random.h>
+
+namespace {
+
+std::uint64_t splitmix64(std::uint64_t & x) {
+  std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+std::uint64_t rotl(std::uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+void next(std::uint64_t (&s)[4]) {
+  const std::uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 45);
+}
+
+// Advance S by 2^128 (JUMP) or 2^192 (LONG_JUMP) steps.
+//
+const std::uint64_t JUMP[] = {
+  0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+  0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+const std::uint64_t LONG_JUMP[] = {
+  0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull,
+  0x77710069854ee241ull, 0x39109bb02acbe635ull};
+
+void jump(std::uint64_t (&s)[4], const std::uint64_t (&poly)[4]) {
+  std::uint64_t t[4] = {0, 0, 0, 0};
+  for (std::uint64_t p : poly) {
+    for (int b = 0; b < 64; b++) {
+      if (p & (std::uint64_t{1} << b))
+        for (int i = 0; i < 4; i++)
+          t[i] ^= s[i];
+      next(s);
+    }
+  }
+  for (int i = 0; i < 4; i++)
+    s[i] = t[i];
+}
+
+} // namespace
+
+namespace libtbx {
+
+std::uint64_t test_seed() {
+  static const std::uint64_t seed = libtb::random<std::uint64_t>();
+  return seed;
+}
+
+// Stream k begins k long jumps from the state expanded from SEED; its lanes
+// are successive jumps from there.
+//
+void Rng::seed_state(std::uint64_t seed) {
+  std::uint64_t s[4];
+  for (std::uint64_t & w : s)
+    w = splitmix64(seed);
+  for (std::uint64_t k = 0; k < stream_; k++)
+    jump(s, LONG_JUMP);
+  for (std::size_t l = 0; l < LANES; l++) {
+    s0_[l] = s[0];
+    s1_[l] = s[1];
+    s2_[l] = s[2];
+    s3_[l] = s[3];
+    jump(s, JUMP);
+  }
+  seeded_ = true;
+  pos_ = LANES;
+}
+
+} // namespace libtbx
@@ -0,0 +1,83 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/scoreboard.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace libtbx {
+
+namespace {
+
+std::vector<ScoreboardBase *> & scoreboards() {
+  static std::vector<ScoreboardBase *> v;
+  return v;
+}
+
+} // namespace
+
+ScoreboardBase::ScoreboardBase(const char * name) : name_(name) {
+  scoreboards().push_back(this);
+}
+
+ScoreboardBase::~ScoreboardBase() {
+  std::vector<ScoreboardBase *> & v = scoreboards();
+  v.erase(std::remove(v.begin(), v.end(), this), v.end());
+}
+
+void ScoreboardBase::report_underflow() {
+  ++underflows_;
+  LIBTB_REPORT_ERROR(name_ + ": unexpected retirement (scoreboard empty)");
+}
+
+void ScoreboardBase::report_overflow() {
+  ++overflows_;
+  LIBTB_REPORT_ERROR(name_ + ": scoreboard overflow");
+}
+
+void report_scoreboards() {
+  for (const ScoreboardBase * sb : scoreboards())
+    std::cout << "[libtbx] scoreboard=" << sb->name()
+              << " matched=" << sb->matched()
+              << " mismatched=" << sb->mismatched()
+              << " underflow=" << sb->underflows()
+              << " overflow=" << sb->overflows()
+              << " pending=" << sb->size()
+              << "\n";
+}
+
+std::size_t clear_scoreboards() {
+  std::size_t n = 0;
+  for (ScoreboardBase * sb : scoreboards()) {
+    n += sb->size();
+    sb->clear();
+  }
+  return n;
+}
+
+} // namespace libtbx
@@ -0,0 +1,131 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/coverage.h>
+#include <libtbx/profile.h>
+#include <libtbx/scoreboard.h>
+#include <libtbx/sim.h>
+#include <libtbx/txlog.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+// Locate the first clock in the design hierarchy (by construction, the clock
+// instantiated by libtb::TopLevel). Simulated cycles are computed from the
+// final simulation time such that no per-cycle accounting is required.
+//
+const sc_core::sc_clock * find_clock(
+    const std::vector<sc_core::sc_object *> & objs) {
+  for (sc_core::sc_object * o : objs) {
+    if (const sc_core::sc_clock * clk = dynamic_cast<sc_core::sc_clock *>(o))
+      return clk;
+    if (const sc_core::sc_clock * clk = find_clock(o->get_child_objects()))
+      return clk;
+  }
+  return nullptr;
+}
+
+// The clock of the design, from which the time at which transactions are
+// logged is derived.
+//
+const sc_core::sc_clock * clk_{nullptr};
+
+std::uint64_t clock_cycles() {
+  return sc_core::sc_time_stamp().value() / clk_->period().value();
+}
+
+std::vector<std::function<void(double)>> & completions() {
+  static std::vector<std::function<void(double)>> v;
+  return v;
+}
+
+} // namespace
+
+namespace libtbx {
+
+const sc_core::sc_clock * design_clock() {
+  if (clk_ == nullptr)
+    clk_ = find_clock(sc_core::sc_get_top_level_objects());
+  return clk_;
+}
+
+void on_complete(const std::function<void(double cycles)> & f) {
+  completions().push_back(f);
+}
+
+void complete(double cycles) {
+  for (const std::function<void(double)> & f : completions())
+    f(cycles);
+}
+
+void report(double cycles, double wall_s) {
+  const double rate = (wall_s > 0) ? (cycles / wall_s) : 0;
+  std::cout << "[libtbx]"
+            << std::fixed << std::setprecision(0)
+            << " cycles=" << cycles
+            << std::setprecision(6)
+            << " wall_s=" << wall_s
+            << std::setprecision(0)
+            << " cycles_per_s=" << rate
+            << "\n";
+}
+
+int run(const std::function<int()> & f) {
+  using clock_type = std::chrono::steady_clock;
+
+  if (!report_knobs())
+    return 1;
+
+  if (design_clock() != nullptr)
+    TxLog::get().set_time(&clock_cycles);
+
+  profile_begin();
+  const clock_type::time_point start = clock_type::now();
+  const int ret = f();
+  const std::chrono::duration<double> wall = clock_type::now() - start;
+  TxLog::get().close();
+  report_scoreboards();
+  report_coverage();
+
+  double cycles = 0;
+  if (clk_ != nullptr)
+    cycles = sc_core::sc_time_stamp() / clk_->period();
+
+  complete(cycles);
+  profile_report(cycles, wall.count());
+  report(cycles, wall.count());
+  return ret;
+}
+
+int start() {
+  return run([]() { return libtb::LibTbContext::start(); });
+}
+
+} // namespace libtbx
@@ -0,0 +1,76 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/sweep.h>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+libtbx::Knob<unsigned> sweep_threads_{
+  "sweep_threads", 0, "Worker threads of a sweep (0: all cores)"};
+libtbx::Knob<std::uint64_t> sweep_inputs_{
+  "sweep_inputs", 0, "Inputs swept, from zero (0: the whole space)"};
+libtbx::Knob<std::size_t> sweep_report_{
+  "sweep_report", 16, "Failing inputs reported"};
+
+} // namespace
+
+namespace libtbx {
+
+const SweepOptions & sweep_options() {
+  static const SweepOptions opts{sweep_threads_, sweep_inputs_, sweep_report_};
+  return opts;
+}
+
+int report_sweep(std::vector<std::uint64_t> & fails, std::uint64_t failed,
+                 std::uint64_t n, unsigned threads, double wall_s) {
+  std::sort(fails.begin(), fails.end());
+  if (fails.size() > sweep_options().report)
+    fails.resize(sweep_options().report);
+  for (std::uint64_t i : fails)
+    std::cout << "[libtbx] sweep fail input=0x" << std::hex << i << std::dec
+              << "\n";
+
+  const double rate = (wall_s > 0) ? (n / wall_s) : 0;
+  const std::ios_base::fmtflags flags = std::cout.flags();
+  const std::streamsize precision = std::cout.precision();
+  std::cout << "[libtbx] sweep"
+            << " inputs=" << n
+            << " failed=" << failed
+            << " threads=" << threads
+            << std::fixed << std::setprecision(6)
+            << " wall_s=" << wall_s
+            << std::setprecision(0)
+            << " inputs_per_s=" << rate
+            << "\n";
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+  return (failed != 0) ? 1 : 0;
+}
+
+} // namespace libtbx
@@ -0,0 +1,97 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/scoreboard.h>
+#include <libtbx/testlist.h>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+int error_count() {
+  return sc_core::sc_report_handler::get_count(sc_core::SC_ERROR) +
+         sc_core::sc_report_handler::get_count(sc_core::SC_FATAL);
+}
+
+} // namespace
+
+namespace libtbx {
+
+TestList::TestList(std::function<void()> reset) : reset_(reset) {}
+
+void TestList::add(const char * name, std::function<void()> f) {
+  tests_.push_back(Test{name, f});
+}
+
+bool TestList::run() {
+  std::vector<const Test *> selected;
+  if (select_.get().empty()) {
+    for (const Test & t : tests_)
+      selected.push_back(&t);
+  } else {
+    std::istringstream ss{select_.get()};
+    std::string name;
+    while (std::getline(ss, name, ',')) {
+      if (name.empty())
+        continue;
+      const Test * found = nullptr;
+      for (const Test & t : tests_)
+        if (t.name == name)
+          found = &t;
+      if (found == nullptr) {
+        LIBTB_REPORT_ERROR("Unknown test: " + name);
+        return false;
+      }
+      selected.push_back(found);
+    }
+  }
+
+  for (std::size_t i = 0; i < selected.size(); i++) {
+    const Test & t = *selected[i];
+    if (i != 0)
+      reset_();
+    const int errors = error_count();
+    t.f();
+
+    // Expectations outstanding upon completion of a test, the last included,
+    // fail the test, and are discarded before the design is reset.
+    //
+    if (const std::size_t n = clear_scoreboards()) {
+      std::stringstream ss;
+      ss << t.name << ": " << n << " expectations outstanding";
+      LIBTB_REPORT_ERROR(ss.str());
+    }
+    const int failed = error_count() - errors;
+    std::cout << "[libtbx] test=" << t.name
+              << " result=" << ((failed == 0) ? "PASS" : "FAIL")
+              << " errors=" << failed
+              << "\n";
+  }
+  return true;
+}
+
+} // namespace libtbx
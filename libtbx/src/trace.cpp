@@ -0,0 +1,70 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/knob.h>
+#include <libtbx/trace.h>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+libtbx::Knob<std::string> trace_{
+  "trace", "", "Trace the model to the named FST file"};
+libtbx::Knob<std::uint64_t> trace_start_{
+  "trace_start", 0, "First cycle traced"};
+libtbx::Knob<std::uint64_t> trace_stop_{
+  "trace_stop", 0, "Cycle at which tracing stops (0: end of simulation)"};
+libtbx::Knob<std::string> trace_scopes_{
+  "trace_scopes", "", "Comma-separated scopes traced (default: all)"};
+
+} // namespace
+
+namespace libtbx {
+
+const TraceOptions & trace_options() {
+  static TraceOptions opts;
+  static bool init = false;
+  if (!init) {
+    opts.file = trace_;
+    opts.start = trace_start_;
+    opts.stop = trace_stop_;
+    std::istringstream ss{trace_scopes_.get()};
+    std::string scope;
+    while (std::getline(ss, scope, ','))
+      if (!scope.empty())
+        opts.scopes.push_back(scope);
+    init = true;
+  }
+  return opts;
+}
+
+void trace_unavailable() {
+  std::cerr << "[libtbx] trace requested of a model which is not traced; "
+            << "run the debug model\n";
+}
+
+} // namespace libtbx
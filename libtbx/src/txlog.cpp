@@ -0,0 +1,119 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtbx/txlog.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace libtbx {
+
+namespace {
+
+// Records buffered before being written.
+//
+constexpr std::size_t BUFFER_N = 4096;
+
+} // namespace
+
+TxLog & TxLog::get() {
+  static TxLog log;
+  return log;
+}
+
+// The log is opened upon construction if LIBTBX_TXLOG names a file.
+//
+TxLog::TxLog() : buf_(BUFFER_N) {
+  if (const char * fn = std::getenv("LIBTBX_TXLOG"))
+    open(fn);
+}
+
+TxLog::~TxLog() {
+  close();
+}
+
+bool TxLog::open(const std::string & fn) {
+  close();
+  f_ = std::fopen(fn.c_str(), "wb");
+  if (f_ == nullptr) {
+    std::cerr << "[libtbx] unable to open transaction log " << fn << "\n";
+    return false;
+  }
+  TxHeader h;
+  std::memcpy(h.magic, TX_MAGIC, sizeof(h.magic));
+  h.version = TX_VERSION;
+  h.record_size = sizeof(TxRecord);
+  std::fwrite(&h, sizeof(h), 1, f_);
+  return true;
+}
+
+void TxLog::close() {
+  if (f_ == nullptr)
+    return;
+  flush();
+  std::fclose(f_);
+  f_ = nullptr;
+}
+
+std::uint32_t TxLog::declare(const std::string & descriptor) {
+  const std::uint32_t id = next_id_++;
+  append(TX_DECLARE, id, descriptor.size(), 0, 0, 0);
+
+  const std::size_t n = (descriptor.size() + sizeof(TxRecord) - 1) /
+      sizeof(TxRecord);
+  for (std::size_t i = 0; i < n; i++) {
+    if (n_ == buf_.size())
+      flush();
+    TxRecord & r = buf_[n_++];
+    std::memset(&r, 0, sizeof(r));
+    const std::size_t off = i * sizeof(TxRecord);
+    std::memcpy(&r, descriptor.data() + off,
+                std::min(sizeof(TxRecord), descriptor.size() - off));
+  }
+  return id;
+}
+
+void TxLog::flush() {
+  if ((f_ != nullptr) && (n_ != 0))
+    std::fwrite(buf_.data(), sizeof(TxRecord), n_, f_);
+  n_ = 0;
+}
+
+TxInterface::TxInterface(
+    const char * name, std::initializer_list<const char *> fields)
+    : descriptor_(name) {
+  descriptor_ += ':';
+  std::size_t i = 0;
+  for (const char * f : fields) {
+    if (i++ != 0)
+      descriptor_ += ',';
+    descriptor_ += f;
+  }
+}
+
+} // namespace libtbx
@@ -0,0 +1,170 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtb.h>
+#include <libtbx/knob.h>
+#include <libtbx/wave.h>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+libtbx::Knob<std::string> wave_ring_{
+  "wave_ring", "", "Upon the first error, write recent cycles to this file"};
+libtbx::Knob<std::size_t> wave_ring_cycles_{
+  "wave_ring_cycles", 4096, "Cycles retained by wave_ring"};
+
+libtbx::WaveRing::writer_type writer_{nullptr};
+const char * writer_suffix_{""};
+
+// The ring flushed upon the first error, and the report handler it displaced.
+//
+const libtbx::WaveRing * active_{nullptr};
+sc_core::sc_report_handler_proc next_handler_{nullptr};
+
+void report_handler(const sc_core::sc_report & r,
+                    const sc_core::sc_actions & a) {
+  if (active_ != nullptr && r.get_severity() >= sc_core::SC_ERROR) {
+    const libtbx::WaveRing * ring = active_;
+    active_ = nullptr;
+    ring->flush(wave_ring_.get());
+  }
+  next_handler_(r, a);
+}
+
+bool write_vcd(const libtbx::WaveRing & r, const std::string & fn) {
+  std::ofstream os{fn};
+  if (!os)
+    return false;
+  os << "$timescale 1ns $end\n"
+     << "$scope module tb $end\n";
+  auto id = [](std::size_t p) {
+    std::string s;
+    do {
+      s += static_cast<char>('!' + (p % 94));
+      p /= 94;
+    } while (p != 0);
+    return s;
+  };
+  for (std::size_t p = 0; p < r.probes(); p++)
+    os << "$var wire " << r.bits(p) << " " << id(p) << " " << r.name(p)
+       << " $end\n";
+  os << "$upscope $end\n"
+     << "$enddefinitions $end\n";
+
+  for (std::size_t i = 0; i < r.cycles(); i++) {
+    os << "#" << (r.first_cycle() + i) << "\n";
+    for (std::size_t p = 0; p < r.probes(); p++) {
+      const std::uint64_t x = r.value(i, p);
+      if (i != 0 && x == r.value(i - 1, p))
+        continue;
+      if (r.bits(p) == 1) {
+        os << (x & 1) << id(p) << "\n";
+      } else {
+        os << "b";
+        for (unsigned b = r.bits(p); b-- != 0;)
+          os << ((x >> b) & 1);
+        os << " " << id(p) << "\n";
+      }
+    }
+  }
+  return static_cast<bool>(os);
+}
+
+} // namespace
+
+namespace libtbx {
+
+WaveRing::WaveRing() : depth_(0) {
+  if (wave_ring_.get().empty())
+    return;
+  depth_ = wave_ring_cycles_;
+  if (depth_ != 0 && active_ == nullptr) {
+    active_ = this;
+    next_handler_ = sc_core::sc_report_handler::set_handler(&report_handler);
+    if (next_handler_ == nullptr)
+      next_handler_ = &sc_core::sc_report_handler::default_handler;
+  }
+}
+
+WaveRing::~WaveRing() {
+  if (active_ == this)
+    active_ = nullptr;
+}
+
+void WaveRing::probe(const std::string & name, unsigned bits,
+                     std::function<std::uint64_t()> f) {
+  names_.push_back(name);
+  bits_.push_back(bits);
+  fs_.push_back(f);
+}
+
+void WaveRing::sample_all() {
+  if (ring_.empty())
+    ring_.resize(depth_ * fs_.size());
+  std::uint64_t * row = &ring_[(n_ % depth_) * fs_.size()];
+  for (const std::function<std::uint64_t()> & f : fs_)
+    *row++ = f();
+  ++n_;
+}
+
+std::size_t WaveRing::cycles() const {
+  return (n_ < depth_) ? n_ : depth_;
+}
+
+std::uint64_t WaveRing::first_cycle() const {
+  return n_ - cycles();
+}
+
+std::uint64_t WaveRing::value(std::size_t i, std::size_t p) const {
+  return ring_[((first_cycle() + i) % depth_) * fs_.size() + p];
+}
+
+void WaveRing::set_writer(writer_type w, const char * suffix) {
+  writer_ = w;
+  writer_suffix_ = suffix;
+}
+
+void WaveRing::flush(const std::string & fn) const {
+  std::string out = fn;
+  bool ok;
+  if (writer_ != nullptr) {
+    out += writer_suffix_;
+    ok = writer_(*this, out);
+  } else {
+    out += ".vcd";
+    ok = write_vcd(*this, out);
+  }
+  if (ok) {
+    std::cout << "[libtbx] wave_ring wrote " << cycles() << " cycles to "
+              << out << "\n";
+  } else {
+    std::cerr << "[libtbx] wave_ring failed to write " << out << "\n";
+  }
+}
+
+} // namespace libtbx
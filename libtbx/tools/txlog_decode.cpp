@@ -0,0 +1,159 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+// Render a transaction log written by libtbx::TxLog as text or CSV.
+//
+//   txlog_decode [--csv] [--hex] <log>
+//
+// Text output is one line per transaction:
+//
+//   <time> <interface> <field>=<value> ... [ERROR]
+//
+// CSV output is one line per transaction with the columns time, interface,
+// error, followed by the payload fields f0, f1, ... in the order in which
+// they were declared by the interface.
+//
+
+#include <libtbx/txlog.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Interface {
+  std::string name;
+  std::vector<std::string> fields;
+};
+
+Interface parse_descriptor(const std::string & d) {
+  Interface i;
+  const std::size_t colon = d.find(':');
+  i.name = d.substr(0, colon);
+  if (colon == std::string::npos)
+    return i;
+  std::stringstream ss(d.substr(colon + 1));
+  std::string f;
+  while (std::getline(ss, f, ','))
+    i.fields.push_back(f);
+  return i;
+}
+
+int usage(const char * argv0) {
+  std::cerr << "usage: " << argv0 << " [--csv] [--hex] <log>\n";
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+  using namespace libtbx;
+
+  bool csv = false;
+  bool hex = false;
+  const char * fn = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--csv") == 0)
+      csv = true;
+    else if (std::strcmp(argv[i], "--hex") == 0)
+      hex = true;
+    else if (fn == nullptr)
+      fn = argv[i];
+    else
+      return usage(argv[0]);
+  }
+  if (fn == nullptr)
+    return usage(argv[0]);
+
+  std::FILE * f = std::fopen(fn, "rb");
+  if (f == nullptr) {
+    std::cerr << "unable to open " << fn << "\n";
+    return 1;
+  }
+
+  TxHeader h;
+  if ((std::fread(&h, sizeof(h), 1, f) != 1) ||
+      (std::memcmp(h.magic, TX_MAGIC, sizeof(h.magic)) != 0)) {
+    std::cerr << fn << ": not a transaction log\n";
+    return 1;
+  }
+  if ((h.version != TX_VERSION) || (h.record_size != sizeof(TxRecord))) {
+    std::cerr << fn << ": unsupported version " << h.version << "\n";
+    return 1;
+  }
+
+  if (csv)
+    std::cout << "time,interface,error,f0,f1,f2,f3\n";
+
+  std::map<std::uint32_t, Interface> ifaces;
+  TxRecord r;
+  while (std::fread(&r, sizeof(r), 1, f) == 1) {
+    if (r.iface == TX_DECLARE) {
+      std::string d(r.data[0], '\0');
+      const std::size_t n = (d.size() + sizeof(TxRecord) - 1) /
+          sizeof(TxRecord);
+      std::vector<TxRecord> text(n);
+      if (std::fread(text.data(), sizeof(TxRecord), n, f) != n) {
+        std::cerr << fn << ": truncated declaration\n";
+        return 1;
+      }
+      std::memcpy(&d[0], text.data(), d.size());
+      ifaces[r.flags] = parse_descriptor(d);
+      continue;
+    }
+
+    auto it = ifaces.find(r.iface);
+    if (it == ifaces.end()) {
+      std::cerr << fn << ": undeclared interface " << r.iface << "\n";
+      return 1;
+    }
+    const Interface & i = it->second;
+    const bool error = (r.flags & TX_FLAG_ERROR) != 0;
+
+    std::cout << r.time << (csv ? "," : " ") << i.name;
+    if (csv)
+      std::cout << "," << (error ? 1 : 0);
+    if (hex)
+      std::cout << std::hex;
+    for (std::size_t n = 0; n < i.fields.size() && n < TX_FIELDS_N; n++) {
+      if (csv)
+        std::cout << "," << r.data[n];
+      else
+        std::cout << " " << i.fields[n] << "=" << r.data[n];
+    }
+    std::cout << std::dec;
+    if (!csv && error)
+      std::cout << " ERROR";
+    std::cout << "\n";
+  }
+  std::fclose(f);
+  return 0;
+}
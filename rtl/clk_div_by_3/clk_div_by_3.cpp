@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vclk_div_by_3.h"
 
 #define PORTS(__func)                           \
@@ -34,6 +35,9 @@
 struct ClkDivBy3Tb : libtb::TopLevel
 {
   using UUT = Vclk_div_by_3;
+
+  // Ratio of the input clock to the generated clock.
+  static constexpr int DIVISOR = 3;
   
   SC_HAS_PROCESS(ClkDivBy3Tb);
   ClkDivBy3Tb(sc_core::sc_module_name mn = "t")
@@ -50,16 +54,22 @@ struct ClkDivBy3Tb : libtb::TopLevel
     uut_.__name(__name##_);
     PORTS(__bind_signals)
 #undef __bind_signals
+    mon_.in(clk_div_3_);
   }
 
   bool run_test() {
     LIBTB_REPORT_INFO("Stimulus starts...");
-    wait(1000, SC_NS);
+    t_wait_posedge_clk(N_);
     LIBTB_REPORT_INFO("Stimulus ends.");
 
+    // Each period of the divided clock is checked by the monitor as it
+    // completes; ensure that the clock has not stopped.
+    mon_.recorder().expect_periods(N_ / (2 * DIVISOR));
     return true;
   }
 
+  const libtbx::Knob<int> N_{"cycles", 10000, "Input clock cycles simulated"};
+  libtbx::EdgeMonitor mon_{"mon_clk_div_3", libtbx::ClockSpec{DIVISOR, 0.5}};
   UUT uut_;
 #define __declare_signals(__name, __type)       \
   sc_core::sc_signal<__type> __name##_;
@@ -70,5 +80,5 @@ struct ClkDivBy3Tb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
   using namespace libtb;
-  return LibTbSim<ClkDivBy3Tb>(argc, argv).start();
+  return libtbx::Sim<ClkDivBy3Tb>(argc, argv).start();
 }
@@ -26,17 +26,20 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vcount_ones.h"
 
 #define PORTS(__func)                           \
     __func(A, WordT)                            \
     __func(fail, bool)
 
-const int TB_N = 10000;
+libtbx::Knob<int> TB_N{"vectors", 10000, "Input vectors applied"};
 
 struct CountOnesTb : libtb::TopLevel
 {
     using WordT = uint32_t;
+    // Width of A in count_ones.sv; the remaining bits of WordT are not ports.
+    static constexpr std::size_t A_W = 8;
     SC_HAS_PROCESS(CountOnesTb);
     CountOnesTb(sc_core::sc_module_name mn = "t")
         : uut_("uut")
@@ -56,8 +59,14 @@ struct CountOnesTb : libtb::TopLevel
         A_ = 0;
         t_wait_reset_done();
 
+        // One vector in four has a corner-case population.
+        //
         for (int i = 0; i < TB_N; i++) {
-            A_ = libtb::random<WordT>();
+            if (i % 4 == 0)
+                A_ = libtbx::random_bits_count<WordT>(
+                    rng_, libtbx::corner_count(rng_, A_W), A_W);
+            else
+                A_ = libtbx::random_bits_density<WordT>(rng_, 0.5, A_W);
             t_wait_posedge_clk();
         }
         return false;
@@ -67,6 +76,8 @@ struct CountOnesTb : libtb::TopLevel
         LIBTB_ASSERT_ERROR(!fail_);
     }
 
+    libtbx::Rng rng_;
+
 #define __declare_signals(__name, __type)       \
     sc_core::sc_signal<__type> __name##_;
     PORTS(__declare_signals)
@@ -78,5 +89,5 @@ struct CountOnesTb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<CountOnesTb>(argc, argv).start();
+    return libtbx::Sim<CountOnesTb>(argc, argv).start();
 }
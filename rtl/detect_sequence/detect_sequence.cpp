@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vdetect_sequence.h"
 
 #define PORTS(__func)                           \
@@ -53,8 +54,6 @@ public:
         uut_.__name(__name##_);
         PORTS(__bind_signals)
 #undef __bind_signals
-
-            wave_on("foo.vcd", uut_);
     }
 
     bool run_test()
@@ -78,12 +77,15 @@ public:
     PORTS(__declare_signals)
 #undef __declare_signals
     Vdetect_sequence uut_;
+    libtbx::Trace<Vdetect_sequence> trace_{"trace", uut_};
 };
 
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
+    // Knobs are parsed before the testbench is constructed.
+    const int n = libtbx::parse_knobs(argc, argv);
     DetectSequenceTb t;
-    LibTbContext::init(argc, argv);
-    return LibTbContext::start();
+    LibTbContext::init(n, argv);
+    return libtbx::start();
 }
@@ -26,7 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
-#include <deque>
+#include <libtbx.h>
 #include "Vdiv_by_3.h"
 
 #define PORTS(__func)                           \
@@ -36,29 +36,31 @@
   __func(valid_r, bool)                         \
   __func(y_r, uint32_t)
 
-struct DivBy3Tb : libtb::TopLevel
+struct DivBy3Tb : libtbx::TopLevel
 {
   struct Result {
       uint32_t d, result;
+
+      bool operator==(uint32_t actual) const { return result == actual; }
+      friend std::ostream & operator<<(std::ostream & os, const Result & r) {
+        return os << r.result << " (Oprand: " << r.d << ")";
+      }
   };
 
   using UUT = Vdiv_by_3;
-  SC_HAS_PROCESS(DivBy3Tb);
-  DivBy3Tb(sc_core::sc_module_name mn = "t")
+  LIBTBX_HAS_PROCESS(DivBy3Tb);
+  DivBy3Tb(libtbx::ModuleName mn = "t")
     : uut_("uut")
 #define __construct_signal(__name, __type)      \
       , __name##_(#__name)
       PORTS(__construct_signal)
 #undef __construct_signal
   {
-    SC_METHOD(m_checker);
-    dont_initialize();
-    sensitive << e_tb_sample();
+    LIBTBX_SAMPLE(m_checker);
 
-    uut_.clk(clk());
-    uut_.rst(rst());
+    LIBTBX_BIND_UUT(uut_);
 #define __bind_signal(__name, __type)           \
-    uut_.__name(__name##_);
+    LIBTBX_BIND_PORT(uut_, __name);
     PORTS(__bind_signal)
 #undef __bind_signals
   }
@@ -73,7 +75,7 @@ struct DivBy3Tb : libtb::TopLevel
         x_ = x;
         t_wait_posedge_clk(1);
         pass_ = false;
-        expected_.push_back(Result{x, x / 3});
+        expected_.push(Result{x, x / 3});
 
         // On each round, simply wait until the computation is complete to avoid
         // exposing the TB to any flow-control.
@@ -88,32 +90,16 @@ struct DivBy3Tb : libtb::TopLevel
   void m_checker()
   {
     if (valid_r_) {
-      if (expected_.size() == 0) {
-        std::stringstream ss;
-        ss << "Unexpected result";
-        LIBTB_REPORT_ERROR(ss.str());
-        return;
-      }
-
       const uint32_t actual = y_r_;
-      const Result expected = expected_.front(); expected_.pop_front();
-      if (actual != expected.result) {
-        std::stringstream ss;
-        ss << "Mismatch detected: "
-           << " Oprand: " << expected.d
-           << " Actual: " << actual
-           << " Expected: " << expected.result;
-        LIBTB_REPORT_ERROR(ss.str());
-      } else {
-        std::stringstream ss;
-        ss << "Validated oprand=" << expected.d << " " << actual;
-        LIBTB_REPORT_DEBUG(ss.str());
-      }
+      if (!expected_.empty())
+        LIBTBX_REPORT_DEBUG("Validating oprand=" << expected_.front().d
+                            << " " << actual);
+      expected_.check(actual);
     }
   }
-  std::deque<Result> expected_;
+  libtbx::Scoreboard<Result> expected_{"y_r"};
 #define __declare_signal(__name, __type)        \
-  sc_core::sc_signal<__type> __name##_;
+  libtbx::Signal<__type> __name##_;
   PORTS(__declare_signal)
 #undef __declare_signal
   UUT uut_;
@@ -123,5 +109,5 @@ struct DivBy3Tb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
   using namespace libtb;
-  return LibTbSim<DivBy3Tb>(argc, argv).start();
+  return libtbx::Sim<DivBy3Tb>(argc, argv).start();
 }
@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <sstream>
 #include "Vfibonacci.h"
 
@@ -69,9 +70,7 @@ struct FibonacciTb : libtb::TopLevel
                 ;
             LIBTB_REPORT_ERROR(ss.str());
         } else {
-            std::stringstream ss;
-            ss << "Validated " << actual;
-            LIBTB_REPORT_DEBUG(ss.str());
+            LIBTBX_REPORT_DEBUG("Validated " << actual);
         }
         next_trigger(clk().posedge_event());
     }
@@ -93,5 +92,5 @@ struct FibonacciTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<FibonacciTb>(argc, argv).start();
+    return libtbx::Sim<FibonacciTb>(argc, argv).start();
 }
@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include "fifo_async_tb.h"
+#include <libtbx.h>
 #include <sstream>
 
 fifo_async_tb::fifo_async_tb() : libtb::TopLevel("t"), uut_("uut") {
@@ -112,5 +113,5 @@ int sc_main(int argc, char **argv) {
     using namespace libtb;
     test_0 t;
     LibTbContext::init(argc, argv);
-    return LibTbContext::start();
+    return libtbx::start();
 }
@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <deque>
 #include <sstream>
 #include "Vfifo_multi_push.h"
@@ -198,5 +199,5 @@ struct FifoMultiPushTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<FifoMultiPushTb>(argc, argv).start();
+    return libtbx::Sim<FifoMultiPushTb>(argc, argv).start();
 }
@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <deque>
 #include <sstream>
 #include "Vfifo_n.h"
@@ -65,7 +66,7 @@ struct FifoNTb : libtb::TopLevel
     dont_initialize();
     sensitive << e_tb_sample();
 
-    SC_THREAD(t_popper);
+    co_.spawn(t_popper());
               
     uut_.clk(clk());
     uut_.rst(rst());
@@ -73,6 +74,11 @@ struct FifoNTb : libtb::TopLevel
     uut_.__name(__name##_);
     PORTS(__bind_signals)
 #undef __bind_signals
+
+#define __probe_signals(__name, __type)         \
+    wave_.probe(#__name, __name##_);
+    PORTS(__probe_signals)
+#undef __probe_signals
   }
 
   void b_push_idle()
@@ -119,59 +125,48 @@ struct FifoNTb : libtb::TopLevel
     pop_vq_ = VqT(0);
   }
 
-  void b_pop (VqT vq)
+  libtbx::Task b_pop (VqT vq)
   {
     pop_ = true;
     pop_vq_ = vq;
     const WordT w = fifo_n_[vq].front();
     fifo_n_[vq].pop_front();
-    expectation_.push_back(w);
-    t_wait_posedge_clk(1);
+    expectation_.push(w);
+    co_await co_.posedge(1);
     b_pop_idle();
   }
 
-  void t_popper()
+  libtbx::Task t_popper()
   {
-    t_wait_reset_done();
+    co_await co_.reset_done();
 
-    LIBTB_REPORT_DEBUG("Popper thread begins.");
+    LIBTB_REPORT_DEBUG("Popper coroutine begins.");
     
     while (true) {
-      t_wait_sync();
+      co_await co_.sync();
       const int vq = libtb::random_integer_in_range(OPT_VQ_N-1);
       if (fifo_n_[vq].size() > 0) {
         LIBTB_ASSERT_ERROR(~(empty_r_ | (1 << vq)));
-        b_pop(vq);
+        co_await b_pop(vq);
       } else
-        t_wait_posedge_clk(1);
+        co_await co_.posedge(1);
     }
   }
 
   void m_checker()
   {
+    wave_.sample();
 
     // Check output
-    if (pop_data_valid_r_) {
-
-      if (expectation_.size() == 0) {
-        LIBTB_REPORT_ERROR("Unexpected completion.");
-        return ;
-      }
-
-      const WordT expected = expectation_.front();
-      expectation_.pop_front();
-      const WordT actual = pop_data_w_;
-      if (expected != actual) {
-        std::stringstream ss;
-        ss << "Mismatch detected";
-        LIBTB_REPORT_ERROR(ss.str());
-      }
-    }
+    if (pop_data_valid_r_)
+      expectation_.check(pop_data_w_.read());
   }
 
   const int N{10000};
   std::deque<WordT> fifo_n_[OPT_VQ_N];
-  std::deque<WordT> expectation_;
+  libtbx::Scoreboard<WordT> expectation_{"pop_data"};
+  libtbx::WaveRing wave_;
+  libtbx::CoScheduler co_{*this};
 #define __declare_signals(__name, __type)       \
   sc_core::sc_signal<__type> __name##_;
   PORTS(__declare_signals)
@@ -182,5 +177,5 @@ struct FifoNTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
   using namespace libtb;
-  return LibTbSim<FifoNTb>(argc, argv).start();
+  return libtbx::Sim<FifoNTb>(argc, argv).start();
 }
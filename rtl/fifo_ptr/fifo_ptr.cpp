@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <deque>
 #include <sstream>
 #include "Vfifo_ptr.h"
@@ -43,7 +44,7 @@
 
 template <typename T = vluint32_t>
 struct FifoTb : public libtb::TopLevel {
-  FifoTb() : libtb::TopLevel("t"), uut_("uut") {
+  FifoTb() : libtb::TopLevel("t"), reset_("reset", *this), uut_("uut") {
     bind_rtl();
 //    wave_on("foo.vcd", uut_);
   }
@@ -52,7 +53,7 @@ struct FifoTb : public libtb::TopLevel {
  protected:
   void bind_rtl() {
     uut_.clk(clk());
-    uut_.rst(rst());
+    uut_.rst(reset_.rst());
 #define __connect_ports(__name, __type) uut_.__name(__name##_);
     FIFO_PORTS(__connect_ports)
 #undef __connect_ports
@@ -79,7 +80,7 @@ struct FifoTb : public libtb::TopLevel {
     idle_pop();
     do {
       t_wait_sync();
-    } while (empty_r_);
+    } while (empty_r_ || !pop_en_);
     pop_ = true;;
     commit_ = true;
     t_wait_posedge_clk();
@@ -87,6 +88,10 @@ struct FifoTb : public libtb::TopLevel {
     idle_pop();
     return ret;
   }
+  // Pops are stalled while clear.
+  //
+  bool pop_en_{true};
+  libtbx::TestReset reset_;
   Vfifo_ptr uut_;
 
 #define __declare_signals(__name, __type) sc_core::sc_signal<__type> __name##_;
@@ -94,20 +99,80 @@ struct FifoTb : public libtb::TopLevel {
 #undef __declare_signals
 };
 
+// Capacity of the FIFO (the default of parameter N).
+//
+constexpr int OPT_N = 16;
+
 template <typename T = vluint32_t>
-struct test_0 : public FifoTb<T> {
-  SC_HAS_PROCESS(test_0);
-  test_0() : N_(10000) { SC_THREAD(t_pop); }
+struct FifoPtrTb : public FifoTb<T> {
+  SC_HAS_PROCESS(FifoPtrTb);
+  FifoPtrTb() {
+    SC_THREAD(t_pop);
+
+    tests_.add("test_0", [this]() { test_0(); });
+    tests_.add("test_1", [this]() { test_1(); });
+  }
 
   bool run_test() {
-    LIBTB_REPORT_INFO("Test START");
-    while (N_--) {
+    tests_.run();
+    return true;
+  }
+
+  // Random stream of pushes, popped as soon as they are available.
+  //
+  void test_0() {
+    LIBTB_REPORT_INFO("Test 0 START");
+    int n = N_;
+    while (n--) {
       const T t = libtb::random<T>();
       this->b_push(t);
       beh_model_.push_back(t);
     }
-    LIBTB_REPORT_INFO("Test END");
-    return true;
+    b_drain();
+    LIBTB_REPORT_INFO("Test 0 END");
+  }
+
+  // Fill the FIFO to capacity with the consumer stalled, then drain it.
+  //
+  void test_1() {
+    LIBTB_REPORT_INFO("Test 1 START");
+    this->pop_en_ = false;
+    for (int i = 0; i < OPT_N; i++) {
+      const T t = libtb::random<T>();
+      this->b_push(t);
+      beh_model_.push_back(t);
+    }
+    this->t_wait_sync();
+    if (!this->full_r_)
+      LIBTB_REPORT_ERROR("FIFO not full upon capacity pushes");
+    b_drain();
+    LIBTB_REPORT_INFO("Test 1 END");
+  }
+
+  // At most OPT_N entries are outstanding, each popped within a few cycles;
+  // should any remain beyond DRAIN_CYCLES, the FIFO has lost them.
+  //
+  void b_drain() {
+    const int DRAIN_CYCLES = 4 * OPT_N;
+    this->pop_en_ = true;
+    for (int i = 0; !beh_model_.empty(); i++) {
+      if (i == DRAIN_CYCLES) {
+        std::stringstream ss;
+        ss << "FIFO failed to drain: " << beh_model_.size()
+           << " entries outstanding after " << DRAIN_CYCLES << " cycles";
+        LIBTB_REPORT_ERROR(ss.str());
+        return;
+      }
+      this->t_wait_posedge_clk();
+    }
+  }
+
+  void b_reset() {
+    this->idle_push();
+    this->idle_pop();
+    beh_model_.clear();
+    this->pop_en_ = true;
+    this->reset_.b_reset();
   }
 
   void t_pop() {
@@ -116,24 +181,26 @@ struct test_0 : public FifoTb<T> {
       const T expected = beh_model_.front();
       beh_model_.pop_front();
 
-      std::stringstream ss;
-      ss << "Expected " << std::hex << expected << " Actual " << std::hex
-         << actual;
-
-      if (actual != expected)
+      if (actual != expected) {
+        std::stringstream ss;
+        ss << "Expected " << std::hex << expected << " Actual " << std::hex
+           << actual;
         LIBTB_REPORT_ERROR(ss.str());
-      else
-        LIBTB_REPORT_DEBUG(ss.str());
+      } else {
+        LIBTBX_REPORT_DEBUG("Expected " << std::hex << expected
+                            << " Actual " << std::hex << actual);
+      }
     }
   }
 
-  int N_;
+  const libtbx::Knob<int> N_{"pushes", 10000, "Entries pushed by test_0"};
   std::deque<T> beh_model_;
+  libtbx::TestList tests_{[this]() { b_reset(); }};
 };
 
 int sc_main(int argc, char **argv) {
   using namespace libtb;
-  test_0<> t;
-  LibTbContext::init(argc, argv);
-  return LibTbContext::start();
+  FifoPtrTb<> t;
+  LibTbContext::init(libtbx::parse_knobs(argc, argv), argv);
+  return libtbx::start();
 }
@@ -26,7 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
-#include <deque>
+#include <libtbx.h>
 #include <sstream>
 #include "Vfifo_sr.h"
 
@@ -56,7 +56,7 @@ struct FifoTb : libtb::TopLevel
         SC_METHOD(m_checker);
         sensitive << clk().posedge_event();
 
-        SC_THREAD(t_popper);
+        co_.spawn(t_popper());
 
         uut_.clk(clk());
         uut_.rst(rst());
@@ -82,7 +82,7 @@ struct FifoTb : libtb::TopLevel
         push_ = true;
         push_data_ = d;
         t_wait_posedge_clk();
-        queue_.push_back(d);
+        queue_.push(d);
         push_idle();
     }
 
@@ -100,46 +100,30 @@ struct FifoTb : libtb::TopLevel
         return 0;
     }
 
-    void  t_popper()
+    libtbx::Task t_popper()
     {
         pop_ = false;
 
-        t_wait_posedge_clk(100);
+        co_await co_.posedge(100);
         while (true) {
-          t_wait_sync();
+          co_await co_.sync();
 
           pop_ = !empty_r_;
-          t_wait_posedge_clk();
+          co_await co_.posedge();
         }
     }
 
     void m_checker()
     {
-        if (pop_data_valid_) {
-            const DataT actual = pop_data_;
-
-            if (queue_.size() == 0) {
-                LIBTB_REPORT_ERROR("Unexpected data valid");
-                return ;
-            }
-
-            const DataT expected = queue_.front();
-            queue_.pop_front();
-
-            if (actual != expected) {
-                std::stringstream ss;
-                ss << "Mismatch detected"
-                   << " Actual: " << std::hex << actual
-                   << " Expected: " << std::hex << expected
-                    ;
-                LIBTB_REPORT_ERROR(ss.str());
-            }
-        }
+        if (pop_data_valid_)
+            queue_.check(pop_data_.read());
     }
 
-    std::deque<DataT> queue_;
+    libtbx::Scoreboard<DataT> queue_{"pop_data"};
+    libtbx::CoScheduler co_{*this};
+    libtbx::Activity activity_;
 
-    const int N{100};
+    const libtbx::Knob<int> N{"pushes", 100, "Entries pushed"};
 #define __declare_signals(__name, __type)       \
     sc_core::sc_signal<__type> __name##_;
     PORTS(__declare_signals)
@@ -150,5 +134,5 @@ struct FifoTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<FifoTb>(argc, argv).start();
+    return libtbx::Sim<FifoTb>(argc, argv).start();
 }
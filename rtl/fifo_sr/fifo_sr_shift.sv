@@ -0,0 +1,166 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+// Baseline implementation of fifo_sr: a shift-register queue, against which
+// the switching activity of fifo_sr is measured (see fifo_sr_activity_report).
+// On each push, every entry is shifted one place and the new entry is written
+// at the head; the oldest entry is selected by the occupancy of the queue.
+//
+module fifo_sr_shift #(
+     parameter integer W = 32
+   , parameter integer N = 16
+) (
+
+   //======================================================================== //
+   //                                                                         //
+   // Misc.                                                                   //
+   //                                                                         //
+   //======================================================================== //
+
+     input                                   clk
+   , input                                   rst
+
+   //======================================================================== //
+   //                                                                         //
+   // Push Interface                                                          //
+   //                                                                         //
+   //======================================================================== //
+
+   , input                                   push
+   , input [W-1:0]                           push_data
+
+   //======================================================================== //
+   //                                                                         //
+   // Pop Interface                                                           //
+   //                                                                         //
+   //======================================================================== //
+
+   , input                                   pop
+   //
+   , output logic                            pop_data_valid
+   , output logic [W-1:0]                    pop_data
+
+   //======================================================================== //
+   //                                                                         //
+   // Control/Status Interface                                                //
+   //                                                                         //
+   //======================================================================== //
+
+   //
+   , output logic                            empty_r
+   , output logic                            full_r
+);
+
+  typedef logic [W-1:0]       w_t;
+  typedef logic [$clog2(N+1)-1:0] cnt_t;
+
+  // ======================================================================== //
+  //                                                                          //
+  // Wires                                                                    //
+  //                                                                          //
+  // ======================================================================== //
+
+  //
+  cnt_t                       cnt_r;
+  cnt_t                       cnt_w;
+  logic                       cnt_en;
+  //
+  logic                       empty_w;
+  logic                       full_w;
+  //
+  w_t                         mem_r [N-1:0];
+
+  // ======================================================================== //
+  //                                                                          //
+  // Combinatorial Logic                                                      //
+  //                                                                          //
+  // ======================================================================== //
+
+  // ------------------------------------------------------------------------ //
+  //
+  always_comb
+    begin : cntrl_PROC
+
+      //
+      pop_data_valid    = pop;
+
+      //
+      cnt_en            = (push ^ pop);
+      cnt_w             = push ? (cnt_r + 'b1) : (cnt_r - 'b1);
+
+      //
+      empty_w           = cnt_en ? (cnt_w == '0) : empty_r;
+      full_w            = cnt_en ? (cnt_w == cnt_t'(N)) : full_r;
+
+      //
+      pop_data          = '0;
+      for (int i = 0; i < N; i++)
+        if (cnt_r == cnt_t'(i + 1))
+          pop_data = mem_r [i];
+
+    end // block: cntrl_PROC
+
+  // ======================================================================== //
+  //                                                                          //
+  // Flops                                                                    //
+  //                                                                          //
+  // ======================================================================== //
+
+  // ------------------------------------------------------------------------ //
+  //
+  always_ff @(posedge clk)
+    if (rst)
+      empty_r <= 'b1;
+    else
+      empty_r <= empty_w;
+
+  // ------------------------------------------------------------------------ //
+  //
+  always_ff @(posedge clk)
+    if (rst)
+      full_r <= 'b0;
+    else
+      full_r <= full_w;
+
+  // ------------------------------------------------------------------------ //
+  //
+  always_ff @(posedge clk)
+    if (rst)
+      cnt_r <= '0;
+    else if (cnt_en)
+      cnt_r <= cnt_w;
+
+  // ------------------------------------------------------------------------ //
+  //
+  always_ff @(posedge clk)
+    if (push) begin
+      mem_r [0] <= push_data;
+      for (int i = 1; i < N; i++)
+        mem_r [i] <= mem_r [i - 1];
+    end
+
+endmodule // fifo_sr_shift
@@ -26,7 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
-#include <deque>
+#include <libtbx.h>
 #include "Vfused_multiply_add.h"
 
 #define PORTS(__func)                           \
@@ -80,11 +80,7 @@ struct FMATb : libtb::TopLevel
     cntrl_load_ = true;
     cntrl_init_ = init;
     t_wait_posedge_clk(1);
-    {
-      std::stringstream ss;
-      ss << "Initial state=" << init;
-      LIBTB_REPORT_DEBUG(ss.str());
-    }
+    LIBTBX_REPORT_DEBUG("Initial state=" << init);
     mach.init(init);
     cntrl_load_ = false;
     for (int i = 0; i < 16; i++) {
@@ -96,16 +92,14 @@ struct FMATb : libtb::TopLevel
       m_ = m;
       x_ = x;
       c_ = c;
-      std::stringstream ss;
-      ss << "Y += MX + C ; ("
-         << "M=" << m_ << ","
-         << "X=" << x_ << ","
-         << "C=" << c_
-         << ")";
-      LIBTB_REPORT_DEBUG(ss.str());
+      LIBTBX_REPORT_DEBUG("Y += MX + C ; ("
+                          << "M=" << m_ << ","
+                          << "X=" << x_ << ","
+                          << "C=" << c_
+                          << ")");
       t_wait_posedge_clk();
       mach.apply(m, x, c);
-      expected_.push_back(mach.y_);
+      expected_.push(mach.y_);
     }
     pass_ = false;
     t_wait_posedge_clk(10);
@@ -115,7 +109,7 @@ struct FMATb : libtb::TopLevel
   {
     t_wait_reset_done();
     LIBTB_REPORT_INFO("Stimulus starts...");
-    for (int i = 0; i < 10000; i++)
+    for (int i = 0; i < rounds_; i++)
       run_round();
     LIBTB_REPORT_INFO("Stimulus ends..");
     return false;
@@ -124,29 +118,13 @@ struct FMATb : libtb::TopLevel
   void m_checker()
   {
     if (y_valid_r_) {
-      if (expected_.size() == 0) {
-        std::stringstream ss;
-        ss << "Unexpected result";
-        LIBTB_REPORT_ERROR(ss.str());
-        return;
-      }
-
       const uint32_t actual = y_w_;
-      const uint32_t expected = expected_.front(); expected_.pop_front();
-      if (actual != expected) {
-        std::stringstream ss;
-        ss << "Mismatch detected: "
-           << " Actual: " << actual
-           << " Expected: " << expected;
-        LIBTB_REPORT_ERROR(ss.str());
-      } else {
-        std::stringstream ss;
-        ss << "Validated result=" << expected;
-        LIBTB_REPORT_DEBUG(ss.str());
-      }
+      if (expected_.check(actual))
+        LIBTBX_REPORT_DEBUG("Validated result=" << actual);
     }
   }
-  std::deque<uint32_t> expected_;
+  libtbx::Scoreboard<uint32_t> expected_{"y"};
+  const libtbx::Knob<int> rounds_{"rounds", 10000, "Rounds of stimulus"};
 #define __declare_signal(__name, __type)        \
   sc_core::sc_signal<__type> __name##_;
   PORTS(__declare_signal)
@@ -157,5 +135,5 @@ struct FMATb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<FMATb>(argc, argv).start();
+    return libtbx::Sim<FMATb>(argc, argv).start();
 }
@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vgates_from_MUX2X1.h"
 
 #define PORTS(__func)                           \
@@ -92,5 +93,5 @@ int sc_main(int argc, char **argv)
 {
     using namespace libtb;
 
-    return LibTbSim<GatesFromMux2X1Tb>(argc, argv).start();
+    return libtbx::Sim<GatesFromMux2X1Tb>(argc, argv).start();
 }
@@ -26,13 +26,14 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vincrement.h"
 
 #define PORTS(__func)                           \
     __func(A, WordT)                            \
     __func(fail, bool)
 
-const int TB_N = 10000;
+libtbx::Knob<int> TB_N{"vectors", 10000, "Input vectors applied"};
 
 struct IncrementTb : libtb::TopLevel
 {
@@ -81,5 +82,5 @@ int sc_main(int argc, char **argv)
 {
     using namespace libtb;
 
-    return LibTbSim<IncrementTb>(argc, argv).start();
+    return libtbx::Sim<IncrementTb>(argc, argv).start();
 }
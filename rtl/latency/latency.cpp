@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <sstream>
 #include "delay_pipe.h"
 #include "Vlatency.h"
@@ -46,7 +47,6 @@ public:
     SC_HAS_PROCESS(LatencyTb);
     LatencyTb(sc_core::sc_module_name mn = "t")
         : uut_("uut") {
-        wave_on("foo.vcd", uut_);
         //
         in_flight_pipe_.clk(clk());
         in_flight_pipe_.in(issue_);
@@ -100,9 +100,7 @@ private:
                 LIBTB_REPORT_ERROR(ss.str());
             }
             if (!fail) {
-                std::stringstream ss;
-                ss << "PASS Delay validated=" << expected_delay;
-                LIBTB_REPORT_DEBUG(ss.str());
+                LIBTBX_REPORT_DEBUG("PASS Delay validated=" << expected_delay);
             }
         }
         return false;
@@ -132,13 +130,16 @@ private:
     PORTS(__declare_signals)
 #undef __declare_signals
     Vlatency uut_;
+    libtbx::Trace<Vlatency> trace_{"trace", uut_};
 };
 
 int sc_main(int argc, char **argv)
 {
     using namespace libtb;
 
+    // Knobs are parsed before the testbench is constructed.
+    const int n = libtbx::parse_knobs(argc, argv);
     LatencyTb t;
-    LibTbContext::init(argc, argv);
-    return LibTbContext::start();
+    LibTbContext::init(n, argv);
+    return libtbx::start();
 }
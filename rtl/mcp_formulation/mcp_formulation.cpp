@@ -26,7 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
-#include <deque>
+#include <libtbx.h>
 #include <sstream>
 #include "Vmcp_formulation.h"
 
@@ -89,7 +89,7 @@ struct MCPFormulationTb : libtb::TopLevel
         l_in_pass_r_ = true;
         l_in_r_ = w;
         t_wait_posedge_clk();
-        queue_.push_back(w);
+        queue_.push(w);
         b_idle();
     }
 
@@ -108,22 +108,8 @@ struct MCPFormulationTb : libtb::TopLevel
     }
 
     void m_checker() {
-        if (c_out_pass_r_) {
-            if (queue_.size() == 0) {
-                LIBTB_REPORT_ERROR("Unexpected retirement");
-                return;
-            }
-            const WordT expected = queue_.front();
-            queue_.pop_front();
-            const WordT actual = c_out_r_;
-            if (actual != expected) {
-                std::stringstream ss;
-                ss << "Mismatch:"
-                   << " Expected=" << std::hex << expected
-                   << " Actual=" << std::hex << actual;
-                LIBTB_REPORT_ERROR(ss.str());
-            }
-        }
+        if (c_out_pass_r_)
+            queue_.check(c_out_r_.read());
     }
 
     sc_core::sc_event reset_done_;
@@ -131,7 +117,7 @@ struct MCPFormulationTb : libtb::TopLevel
     sc_core::sc_clock clk2_;
     sc_core::sc_signal<bool> rst2_;
     const int N_{10000};
-    std::deque<WordT> queue_;
+    libtbx::Scoreboard<WordT> queue_{"c_out"};
 #define __declare_signals(__name, __type)       \
     sc_core::sc_signal<__type> __name##_;
     PORTS(__declare_signals)
@@ -142,5 +128,5 @@ struct MCPFormulationTb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<MCPFormulationTb>(argc, argv).start();
+    return libtbx::Sim<MCPFormulationTb>(argc, argv).start();
 }
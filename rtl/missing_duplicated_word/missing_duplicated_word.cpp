@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <vector>
 #include <algorithm>
 #include <sstream>
@@ -70,11 +71,7 @@ struct MissingDuplicatedWordTb : libtb::TopLevel
         std::vector<DatT> d;
         non_duplicated_ =
             libtb::random_integer_in_range((1 << OPT_W) - 1);
-        {
-            std::stringstream ss;
-            ss << "Non duplicated number is: " << non_duplicated_;
-            LIBTB_REPORT_DEBUG(ss.str());
-        }
+        LIBTBX_REPORT_DEBUG("Non duplicated number is: " << non_duplicated_);
 
         d.push_back(non_duplicated_);
         int cnt = OPT_N - 1;
@@ -82,9 +79,7 @@ struct MissingDuplicatedWordTb : libtb::TopLevel
             const DatT duplicated =
                 libtb::random_integer_in_range((1 << OPT_W) - 1);
             if (non_duplicated_ != duplicated) {
-                std::stringstream ss;
-                ss << "Duplicated number is: " << duplicated;
-                LIBTB_REPORT_DEBUG(ss.str());
+                LIBTBX_REPORT_DEBUG("Duplicated number is: " << duplicated);
                 d.push_back(duplicated);
                 d.push_back(duplicated);
                 cnt -= 2;
@@ -143,5 +138,5 @@ struct MissingDuplicatedWordTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<MissingDuplicatedWordTb>(argc, argv).start();
+    return libtbx::Sim<MissingDuplicatedWordTb>(argc, argv).start();
 }
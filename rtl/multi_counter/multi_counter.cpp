@@ -26,12 +26,13 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <vector>
 #include <array>
 #include <sstream>
 #include <algorithm>
-#include <deque>
 #include "Vmulti_counter.h"
+#include "multi_counter_ops.h"
 
 #define PORTS(__func)                           \
     __func(cntr_pass, bool)                     \
@@ -43,59 +44,44 @@
     __func(status_id_r, IdT)                    \
     __func(status_dat_r, DatT)
 
-using IdT = uint32_t;
-using OpT = uint32_t;
-using DatT = uint32_t;
-
 constexpr int OPT_CNTRS_N = 256;
 constexpr int OPT_CNTRS_W = 32;
 
-//
-constexpr OpT OP_NOP  = 0x00;
-constexpr OpT OP_INIT = 0x04;
-constexpr OpT OP_INC  = 0x0C;
-constexpr OpT OP_DEC  = 0x0D;
-constexpr OpT OP_QRY  = 0x18;
+static std::vector<OpT> CMDS{OP_INC, OP_DEC, OP_QRY};
 
-std::string OpT_to_string(OpT op)
+// Coverage bin of each random command.
+//
+std::size_t OpT_to_bin(OpT op)
 {
     switch (op)
     {
-    case OP_NOP: return "NOP";
-    case OP_INIT: return "INIT";
-    case OP_INC: return "INC";
-    case OP_DEC: return "DEC";
-    case OP_QRY: return "QRY";
+    case OP_INC: return 0;
+    case OP_DEC: return 1;
     }
-    return "INVALID";
+    return 2;
 }
 
-static std::vector<OpT> CMDS{OP_INC, OP_DEC, OP_QRY};
-
 //
-class MultiCounterTb : libtb::TopLevel
+class MultiCounterTb : libtbx::TopLevel
 {
     typedef Vmulti_counter UUT_t;
 public:
 
-    SC_HAS_PROCESS(MultiCounterTb);
-    MultiCounterTb(sc_core::sc_module_name mn = "t")
+    LIBTBX_HAS_PROCESS(MultiCounterTb);
+    MultiCounterTb(libtbx::ModuleName mn = "t")
         : uut_("uut")
 #define __construct_signals(__name, __type)     \
           , __name##_(#__name)
           PORTS(__construct_signals)
 #undef __construct_signals
     {
-        wave_on("foo.vcd", uut_);
-        uut_.clk(clk());
-        uut_.rst(rst());
+        LIBTBX_BIND_UUT(uut_);
 #define __bind_signals(__name, __type)          \
-        uut_.__name(__name##_);
+        LIBTBX_BIND_PORT(uut_, __name);
         PORTS(__bind_signals)
 #undef __bind_signals
 
-        SC_METHOD(m_checker);
-        sensitive << e_tb_sample();
+        LIBTBX_SAMPLE(m_checker);
 
         std::fill_n(std::begin(expected_), OPT_CNTRS_N, DatT());
     }
@@ -110,11 +96,26 @@ private:
             b_issue_command(i, OP_INIT, libtb::random<DatT>());
 
         LIBTB_REPORT_INFO("Applying random stimulus");
-        for (int i = 0; i < N_; i++)
-            b_issue_command(
-                libtb::random_integer_in_range(OPT_CNTRS_W-1),
-                *libtb::choose_random(CMDS)
-                );
+        IdT prev_id = OPT_CNTRS_N;
+        std::size_t prev_op = 0;
+        for (int i = 0; (i < N_) && !libtbx::coverage_done(); i++) {
+            IdT id;
+            OpT op;
+            {
+                LIBTBX_PROFILE_SCOPE("stimulus");
+                id = libtb::random_integer_in_range(OPT_CNTRS_W-1);
+                op = *libtb::choose_random(CMDS);
+            }
+            b_issue_command(id, op);
+
+            // Back-to-back commands to the same counter exercise the
+            // forwarding paths of the pipeline.
+            //
+            if (prev_id != OPT_CNTRS_N)
+                cx_fwd_.sample(prev_op, OpT_to_bin(op), id == prev_id);
+            prev_id = id;
+            prev_op = OpT_to_bin(op);
+        }
 
         LIBTB_REPORT_INFO("Checking state");
         for (int i = 0; i < OPT_CNTRS_N; i++)
@@ -138,75 +139,85 @@ private:
         cntr_op_ = op;
         cntr_dat_ = dat;
         t_wait_posedge_clk();
+        tx_cmd_.record(id, op, dat);
+        LIBTBX_REPORT_DEBUG("Issue command:"
+                            << "{"
+                            << "ID=" << id << ","
+                            << "OP=" << OpT_to_string(op) << ","
+                            << "DAT=" << dat
+                            << "}");
         {
-            std::stringstream ss;
-            ss << "Issue command:"
-                << "{"
-                << "ID=" << id << ","
-                << "OP=" << OpT_to_string(op) << ","
-                << "DAT=" << dat
-                << "}";
-           LIBTB_REPORT_DEBUG(ss.str());
-        }
-        switch (op) {
-        case OP_INIT:
-            expected_[id] = dat;
-            break;
-        case OP_INC:
-            ++expected_[id];
-            break;
-        case OP_DEC:
-            --expected_[id];
-            break;
+            LIBTBX_PROFILE_SCOPE("model");
+            switch (op) {
+            case OP_INIT:
+                expected_[id] = dat;
+                break;
+            case OP_INC:
+                ++expected_[id];
+                break;
+            case OP_DEC:
+                --expected_[id];
+                break;
+            }
+            queue_.push(expected_[id]);
         }
-        queue_.push_back(expected_[id]);
         b_issue_idle();
     }
 
     void m_checker() {
+        LIBTBX_PROFILE_SCOPE("checker");
         if (status_pass_r_) {
 
-            const DatT expected = queue_.front();
-            queue_.pop_front();
-
-            if (!status_qry_r_)
+            if (!status_qry_r_) {
+                queue_.pop();
                 return;
+            }
 
             const IdT id = status_id_r_;
             const DatT actual = status_dat_r_;
 
-            std::stringstream ss;
-            if (actual != expected) {
+            const bool pass = queue_.check(actual, [&](const DatT & expected) {
+                tx_status_.record_error(id, actual, expected);
+                std::stringstream ss;
                 ss << "Mismatch"
                    << " ID=" << id
                    << " EXPECTED=" << expected
                    << " ACTUAL=" << actual;
                 LIBTB_REPORT_ERROR(ss.str());
-            } else {
-                ss << "State validated: "
-                   << "{"
-                   << "ID=" << id << ","
-                   << "DAT=" << actual
-                   << "}";
-                LIBTB_REPORT_DEBUG(ss.str());
+              });
+            if (pass) {
+                tx_status_.record(id, actual, actual);
+                LIBTBX_REPORT_DEBUG("State validated: "
+                                    << "{"
+                                    << "ID=" << id << ","
+                                    << "DAT=" << actual
+                                    << "}");
             }
         }
     }
 
-    const int N_{100000};
+    const libtbx::Knob<int> N_{"commands", 100000, "Commands issued"};
+    libtbx::Coverpoint cp_prev_op_{"prev_op", {"INC", "DEC", "QRY"}};
+    libtbx::Coverpoint cp_op_{"op", {"INC", "DEC", "QRY"}};
+    libtbx::Coverpoint cp_same_id_{"same_id", {"no", "yes"}};
+    libtbx::Cross cx_fwd_{"prev_op_x_op_x_same_id",
+                          {&cp_prev_op_, &cp_op_, &cp_same_id_}};
     std::array<DatT, OPT_CNTRS_N> expected_;
-    std::deque<DatT> queue_;
+    libtbx::Scoreboard<DatT> queue_{"status"};
+    libtbx::TxInterface tx_cmd_{"cmd", {"id", "op", "dat"}};
+    libtbx::TxInterface tx_status_{"status", {"id", "dat", "expected"}};
 #define __declare_signals(__name, __type)     \
-    sc_core::sc_signal<__type> __name##_;
+    libtbx::Signal<__type> __name##_;
     PORTS(__declare_signals)
 #undef __declare_signals
  public:
     Vmulti_counter uut_;
+    libtbx::Trace<Vmulti_counter> trace_{"trace", uut_};
 };
 
 int sc_main(int argc, char **argv)
 {
     using namespace libtb;
 
-    return LibTbSim<MultiCounterTb>(argc, argv).start();
+    return libtbx::Sim<MultiCounterTb>(argc, argv).start();
 }
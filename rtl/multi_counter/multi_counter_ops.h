@@ -0,0 +1,61 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#ifndef MULTI_COUNTER_OPS_H
+#define MULTI_COUNTER_OPS_H
+
+#include <cstdint>
+#include <string>
+
+// Command interface common to multi_counter and multi_counter_variants (see
+// multi_counter_pkg::op_t and multi_counter_variants_pkg::op_t).
+//
+using IdT = uint32_t;
+using OpT = uint32_t;
+using DatT = uint32_t;
+
+//
+constexpr OpT OP_NOP  = 0x00;
+constexpr OpT OP_INIT = 0x04;
+constexpr OpT OP_INC  = 0x0C;
+constexpr OpT OP_DEC  = 0x0D;
+constexpr OpT OP_QRY  = 0x18;
+
+inline std::string OpT_to_string(OpT op)
+{
+    switch (op)
+    {
+    case OP_NOP: return "NOP";
+    case OP_INIT: return "INIT";
+    case OP_INC: return "INC";
+    case OP_DEC: return "DEC";
+    case OP_QRY: return "QRY";
+    }
+    return "INVALID";
+}
+
+#endif
@@ -0,0 +1,270 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtb.h>
+#include <libtbx.h>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <sstream>
+#include "Vmulti_counter.h"
+#include "Vmulti_counter_variants.h"
+#include "multi_counter_ops.h"
+
+// Differential testbench: multi_counter and the three solutions of
+// multi_counter_variants are driven by the same command stream, cycle by
+// cycle, and the result of every query compared across all four. There is no
+// reference model; each implementation is checked against the others, such
+// that the cost of a run is dominated by evaluation of the models themselves.
+//
+// The models are verilated with LOCKSTEP_N counters (see EMIT_LOCKSTEP).
+//
+#ifndef LOCKSTEP_N
+#  define LOCKSTEP_N 32
+#endif
+
+constexpr int OPT_CNTRS_N = LOCKSTEP_N;
+
+// Number of cycles after the final command by which all results must have
+// been returned.
+//
+constexpr int OPT_DRAIN_N = 16;
+
+static const std::array<OpT, 3> CMDS{{OP_INC, OP_DEC, OP_QRY}};
+
+class MultiCounterLockstep
+{
+    // Query result streams, one per implementation.
+    //
+    enum Stream { MULTI_COUNTER, S1, S2, S3, STREAMS_N };
+
+    static const char * stream_name(int s)
+    {
+        switch (s)
+        {
+        case MULTI_COUNTER: return "multi_counter";
+        case S1: return "s1";
+        case S2: return "s2";
+        case S3: return "s3";
+        }
+        return "INVALID";
+    }
+
+public:
+
+    MultiCounterLockstep() : mc_("mc"), mcv_("mcv") {}
+
+    int run() {
+        using clock_type = std::chrono::steady_clock;
+
+        libtbx::profile_begin();
+        const clock_type::time_point t0 = clock_type::now();
+
+        b_reset();
+
+        LIBTB_REPORT_INFO("Initializing state");
+        for (int i = 0; i < OPT_CNTRS_N; i++)
+            b_issue_command(i, OP_INIT, static_cast<DatT>(rng_.next()));
+
+        LIBTB_REPORT_INFO("Applying random stimulus");
+        constexpr std::size_t BLOCK = 4096;
+        std::array<std::uint32_t, BLOCK> ids, ops;
+        for (std::size_t n = N_; n != 0;) {
+            const std::size_t k = std::min(n, BLOCK);
+            {
+                LIBTBX_PROFILE_SCOPE("stimulus");
+                rng_.fill_bounded(ids.data(), k, OPT_CNTRS_N);
+                rng_.fill_bounded(ops.data(), k, CMDS.size());
+            }
+            for (std::size_t i = 0; i < k; i++)
+                b_issue_command(ids[i], CMDS[ops[i]]);
+            n -= k;
+        }
+
+        LIBTB_REPORT_INFO("Checking state");
+        for (int i = 0; i < OPT_CNTRS_N; i++)
+            b_issue_command(i, OP_QRY);
+
+        for (int i = 0; i < OPT_DRAIN_N; i++)
+            b_issue_idle();
+        check_drained();
+
+        const std::chrono::duration<double> wall = clock_type::now() - t0;
+        mc_.final();
+        mcv_.final();
+
+        std::stringstream ss;
+        ss << "Compared " << compared_ << " queries across "
+           << STREAMS_N << " implementations";
+        LIBTB_REPORT_INFO(ss.str());
+
+        libtbx::profile_report(cycle_, wall.count());
+        libtbx::report(cycle_, wall.count());
+        return (errors_ != 0) ? 1 : 0;
+    }
+
+private:
+
+    void b_reset() {
+        mc_.rst = 1;
+        mcv_.rst = 1;
+        for (int i = 0; i < 10; i++)
+            b_issue_idle();
+        mc_.rst = 0;
+        mcv_.rst = 0;
+    }
+
+    void b_issue_idle() {
+        drive(false, IdT(), OP_NOP, DatT());
+        step();
+    }
+
+    void b_issue_command(
+        const IdT & id, const OpT & op, const DatT & dat = DatT()) {
+        drive(true, id, op, dat);
+        step();
+        if (op == OP_QRY)
+            ++queries_;
+        LIBTBX_REPORT_DEBUG("Issue command:"
+                            << "{"
+                            << "ID=" << id << ","
+                            << "OP=" << OpT_to_string(op) << ","
+                            << "DAT=" << dat
+                            << "}");
+    }
+
+    void drive(bool pass, const IdT & id, const OpT & op, const DatT & dat) {
+        mc_.cntr_pass = pass;
+        mc_.cntr_id = id;
+        mc_.cntr_op = op;
+        mc_.cntr_dat = dat;
+
+        mcv_.cmd_pass = pass;
+        mcv_.cmd_id = id;
+        mcv_.cmd_op = op;
+        mcv_.cmd_dat = dat;
+    }
+
+    // Advance all models by one cycle, collecting the results registered upon
+    // the rising edge.
+    //
+    void step() {
+        mc_.clk = 1;
+        mcv_.clk = 1;
+        eval();
+
+        if (mc_.status_pass_r && mc_.status_qry_r)
+            results_[MULTI_COUNTER].push_back(mc_.status_dat_r);
+        if (mcv_.s1_pass_r)
+            results_[S1].push_back(mcv_.s1_dat_r);
+        if (mcv_.s2_pass_r)
+            results_[S2].push_back(mcv_.s2_dat_r);
+        if (mcv_.s3_pass_r)
+            results_[S3].push_back(mcv_.s3_dat_r);
+        compare();
+
+        mc_.clk = 0;
+        mcv_.clk = 0;
+        eval();
+        ++cycle_;
+    }
+
+    void eval() {
+        {
+            LIBTBX_PROFILE_SCOPE("multi_counter");
+            mc_.eval();
+        }
+        {
+            LIBTBX_PROFILE_SCOPE("multi_counter_variants");
+            mcv_.eval();
+        }
+    }
+
+    // Retire each query for which all implementations have returned a result.
+    //
+    void compare() {
+        LIBTBX_PROFILE_SCOPE("checker");
+        while (true) {
+            for (const std::deque<DatT> & r : results_)
+                if (r.empty())
+                    return;
+
+            const DatT dat = results_[MULTI_COUNTER].front();
+            bool pass = true;
+            for (const std::deque<DatT> & r : results_)
+                pass &= (r.front() == dat);
+
+            if (!pass) {
+                std::stringstream ss;
+                ss << "Mismatch QUERY=" << compared_;
+                for (int s = 0; s < STREAMS_N; s++)
+                    ss << " " << stream_name(s) << "=" << results_[s].front();
+                LIBTB_REPORT_ERROR(ss.str());
+                ++errors_;
+            }
+
+            for (std::deque<DatT> & r : results_)
+                r.pop_front();
+            ++compared_;
+        }
+    }
+
+    void check_drained() {
+        for (int s = 0; s < STREAMS_N; s++) {
+            const std::size_t returned = compared_ + results_[s].size();
+            if (returned != queries_) {
+                std::stringstream ss;
+                ss << stream_name(s) << ": " << returned << " of "
+                   << queries_ << " queries returned";
+                LIBTB_REPORT_ERROR(ss.str());
+                ++errors_;
+            }
+        }
+    }
+
+    const libtbx::Knob<std::size_t> N_{
+        "commands", 1000000, "Commands issued"};
+    libtbx::Rng rng_;
+    std::array<std::deque<DatT>, STREAMS_N> results_;
+    std::uint64_t cycle_{0};
+    std::size_t queries_{0};
+    std::size_t compared_{0};
+    int errors_{0};
+    Vmulti_counter mc_;
+    Vmulti_counter_variants mcv_;
+};
+
+int sc_main(int argc, char **argv)
+{
+    using namespace libtb;
+
+    MultiCounterLockstep t;
+    LibTbContext::init(libtbx::parse_knobs(argc, argv), argv);
+    if (!libtbx::report_knobs())
+        return 1;
+    return t.run();
+}
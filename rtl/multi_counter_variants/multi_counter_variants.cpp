@@ -26,10 +26,12 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <array>
 #include <deque>
 //
 #include "Vmulti_counter_variants.h"
+#include "multi_counter_ops.h"
 
 #define PORTS(__func)                           \
     __func(cmd_pass, bool)                      \
@@ -47,17 +49,6 @@
 constexpr int OPT_CNTRS_N = 32;
 constexpr int OPT_CNTRS_W = 32;
 
-using IdT = uint32_t;
-using OpT = uint32_t;
-using DatT = uint32_t;
-
-//
-constexpr OpT OP_NOP  = 0x00;
-constexpr OpT OP_INIT = 0x04;
-constexpr OpT OP_INC  = 0x0C;
-constexpr OpT OP_DEC  = 0x0D;
-constexpr OpT OP_QRY  = 0x18;
-
 class MultiCounterVariantsTb : libtb::TopLevel
 {
 public:
@@ -101,25 +92,19 @@ public:
       
         if (s1_pass_r_)
         {
-            std::stringstream ss;
-            ss << "S1 Query returns: " << s1_dat_r_;
-            LIBTB_REPORT_DEBUG(ss.str());
+            LIBTBX_REPORT_DEBUG("S1 Query returns: " << s1_dat_r_);
             do_check(s1_dat_r_, expect_[1]);
         }
 
         if (s2_pass_r_)
         {
-            std::stringstream ss;
-            ss << "S2 Query returns: " << s2_dat_r_;
-            LIBTB_REPORT_DEBUG(ss.str());
+            LIBTBX_REPORT_DEBUG("S2 Query returns: " << s2_dat_r_);
             do_check(s2_dat_r_, expect_[2]);
         }
 
         if (s3_pass_r_)
         {
-            std::stringstream ss;
-            ss << "S3 Query returns: " << s3_dat_r_;
-            LIBTB_REPORT_DEBUG(ss.str());
+            LIBTBX_REPORT_DEBUG("S3 Query returns: " << s3_dat_r_);
             do_check(s3_dat_r_, expect_[3]);
         }
     }
@@ -186,7 +171,8 @@ public:
     }
 
     const bool apply_stimulus_{true};
-    const int N_{100000};
+    const libtbx::Knob<int> N_{
+        "commands", 100000, "Commands issued (and initial counter value)"};
     std::vector<OpT> cmds{OP_INC, OP_DEC};
     std::array<DatT, OPT_CNTRS_N> cntrs_;
     std::array<std::deque<DatT>, OPT_CNTRS_N> expect_;
@@ -202,5 +188,5 @@ public:
 int sc_main(int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<MultiCounterVariantsTb>(argc, argv).start();
+    return libtbx::Sim<MultiCounterVariantsTb>(argc, argv).start();
 }
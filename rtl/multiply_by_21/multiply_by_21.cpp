@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <sstream>
 #include "Vmultiply_by_21.h"
 
@@ -82,5 +83,5 @@ struct MultiplyBy21Tb : libtb::TopLevel
 
 int sc_main (int argc, char **argv)
 {
-  return libtb::LibTbSim<MultiplyBy21Tb>(argc, argv).start();
+  return libtbx::Sim<MultiplyBy21Tb>(argc, argv).start();
 }
@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <sstream>
 #include "Vone_or_two.h"
 
@@ -69,60 +70,28 @@ private:
         fail |= ((cnt == 1) && !has_set_1_);
         fail |= ((cnt > 1) && !has_set_more_than_1_);
 
-        std::stringstream ss;
-        ss << "Actual: " << std::hex << actual
-           << "{"
-           << "has_set_0=" << std::boolalpha << has_set_0_ << ","
-           << "has_set_1=" << std::boolalpha << has_set_1_ << ","
-           << "has_set_more_than_1=" << std::boolalpha << has_set_more_than_1_
-           << "}";
-
-        LIBTB_REPORT_DEBUG(ss.str());
+        LIBTBX_REPORT_DEBUG("Actual: " << std::hex << actual
+                            << "{"
+                            << "has_set_0=" << std::boolalpha << has_set_0_
+                            << ","
+                            << "has_set_1=" << std::boolalpha << has_set_1_
+                            << ","
+                            << "has_set_more_than_1=" << std::boolalpha
+                            << has_set_more_than_1_
+                            << "}");
 
         if (fail)
             LIBTB_REPORT_ERROR("Failure");
     }
 
-    WordT by_bits_set(int n = 0)
+    WordT by_bits_set(int n)
     {
-        // Construct 0b set
-        if (n == 0)
-            return 0;
-
-        // Construct >2b set
-        if (n == -1) {
-            WordT w;
-
-            do {
-                w = libtb::random<WordT>();
-            } while (libtb::pop_count(w) <= 2);
-
-            return w;
-        }
-
-        // Construct 1b set
-        const WordT one_set = (1 << libtb::random_integer_in_range(30));
-        if (n == 1)
-            return one_set;
-
-        // Construct 2b set
-        if (n == 2) {
-            WordT two_set;
-            do {
-                two_set = one_set | (1 << libtb::random_integer_in_range(30));
-            } while (libtb::pop_count(two_set) != 2);
-
-            return two_set;
-        }
-
-        // Never reached, hopefully!
-        LIBTB_REPORT_FATAL("Unable to construct stimulus");
-        return -1;
+        return libtbx::random_bits_count<WordT>(rng_, n, OPT_W);
     }
 
     WordT get_stimulus()
     {
-        const int i = libtb::random_integer_in_range(100);
+        const int i = rng_.bounded(100);
 
         if (i < 10)
             return by_bits_set(0);
@@ -133,7 +102,10 @@ private:
         if (i < 30)
             return by_bits_set(2);
 
-        return by_bits_set(-1);
+        // More than 2b set; the population is chosen uniformly such that
+        // dense vectors (up to all bits set) are covered.
+        //
+        return by_bits_set(3 + rng_.bounded(OPT_W - 2));
     }
 
     bool run_test() {
@@ -142,9 +114,7 @@ private:
         {
             const WordT x = get_stimulus();
             x_ = x;
-            std::stringstream ss;
-            ss << "Attempting x=" << std::hex << x_;
-            LIBTB_REPORT_DEBUG(ss.str());
+            LIBTBX_REPORT_DEBUG("Attempting x=" << std::hex << x_);
             t_wait_posedge_clk();
         }
         return false;
@@ -157,6 +127,7 @@ private:
 #undef __signals
 
     Vone_or_two uut_;
+    libtbx::Rng rng_;
     const int N_{10000};
 };
 
@@ -164,7 +135,9 @@ int sc_main(int argc, char **argv)
 {
     using namespace libtb;
 
+    // Knobs are parsed before the testbench is constructed.
+    const int n = libtbx::parse_knobs(argc, argv);
     OneOrTwoTb t;
-    LibTbContext::init(argc, argv);
-    return LibTbContext::start();
+    LibTbContext::init(n, argv);
+    return libtbx::start();
 }
@@ -0,0 +1,52 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtb.h>
+#include <libtbx.h>
+#include "Vone_or_two.h"
+
+// Exhaustive sweep of all 2^33 inputs (see <libtbx/sweep.h>): X in bits
+// [31:0] and INV in bit 32. The model has no fail output; its outputs are
+// instead checked against the population count of X, inverted by INV.
+//
+int sc_main(int argc, char **argv)
+{
+    return libtbx::sweep<Vone_or_two>(
+        argc, argv, std::uint64_t{1} << 33,
+        [](Vone_or_two & uut, std::uint64_t i) {
+            const bool inv = (i >> 32) & 1;
+            const std::uint32_t x = static_cast<std::uint32_t>(i);
+            uut.x = x;
+            uut.inv = inv;
+            uut.eval();
+
+            const int cnt = __builtin_popcount(inv ? ~x : x);
+            return (uut.has_set_0 == (cnt == 0)) &&
+                   (uut.has_set_1 == (cnt == 1)) &&
+                   (uut.has_set_more_than_1 == (cnt > 1));
+        });
+}
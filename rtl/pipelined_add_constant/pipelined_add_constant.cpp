@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vpipelined_add_constant.h"
 
 #define PORTS(__func)                           \
@@ -81,5 +82,5 @@ public:
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<Pipelined_add_constantTb>(argc, argv).start();
+    return libtbx::Sim<Pipelined_add_constantTb>(argc, argv).start();
 }
@@ -26,9 +26,9 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <array>
 #include <list>
-#include <deque>
 #include <algorithm>
 #include <sstream>
 #include <iterator>
@@ -77,8 +77,11 @@ std::string op_to_string(int op) {
     }
 }
 
-constexpr int OPT_UPDATES = 100000;
-constexpr int OPT_QUERIES = 100000;
+libtbx::Knob<int> OPT_UPDATES{
+    "updates", 100000, "Update commands issued in each phase"};
+libtbx::Knob<int> OPT_QUERIES{"queries", 100000, "Query commands issued"};
+libtbx::Knob<bool> OPT_MODEL_THREAD{
+    "model_thread", true, "Evaluate the reference model upon its own thread"};
 constexpr int N = 4;
 constexpr int M = 64;
 
@@ -103,6 +106,15 @@ struct Update
     SizeT s;
 };
 
+// Command to the reference model, issued in simulation order.
+//
+struct ModelCmd
+{
+    bool is_query;
+    Update u;
+    Query q;
+};
+
 struct Entry
 {
     KeyT key;
@@ -159,6 +171,14 @@ struct MachineModel
 {
     using ListTable = std::array<std::vector<Entry>, M>;
 
+    // A model evaluated away from the simulation thread must not report.
+    //
+    explicit MachineModel(bool report = true) : report_(report) {}
+
+    // Retain the list state in each QueryResult, for the report of a mismatch.
+    //
+    void retain_state(bool retain) { retain_state_ = retain; }
+
     std::set<IdT> active_updates_{};
 
     void update_actives() {
@@ -216,18 +236,6 @@ struct MachineModel
     }
 
     void apply_query(const Query & q, QueryResult & qr) {
-
-        {
-            std::stringstream ss;
-            ss << "Issuing Query:"
-               << "{"
-               << "id:" << q.id << ","
-               << "level:" << q.l
-               << "}"
-                ;
-            LIBTB_REPORT_DEBUG(ss.str());
-        }
-
         auto & es = t_[q.id];
 
         qr.key = 0;
@@ -250,24 +258,49 @@ struct MachineModel
         qr.key = it->key;
         qr.size = it->size;
         qr.listsize = es.size();
-        qr.dbg_ = es;
+
+        // List state is retained only to be reported upon a mismatch.
+        //
+        if (retain_state_)
+            qr.dbg_ = es;
     }
 
-    bool update(IdT id, OpT op, KeyT k = KeyT(), SizeT s = SizeT()) {
+    // Checkpoint and restore of the list state.
+    //
+    void save(libtbx::SaveStream & os) {
+        for (std::vector<Entry> & es : t_) {
+            vluint64_t n = es.size();
+            os << n;
+            for (Entry & e : es)
+                os << e.key << e.size;
+        }
+    }
 
-        {
-            std::stringstream ss;
-            ss << "Applying state update:"
-               << "{"
-               << "id:" << id << ","
-               << "op:" << op_to_string(op) << ","
-               << std::hex
-               << "key:" << k << ","
-               << "size:" << s
-               << "}"
-                ;
-            LIBTB_REPORT_DEBUG(ss.str());
+    void restore(libtbx::RestoreStream & is) {
+        for (std::vector<Entry> & es : t_) {
+            vluint64_t n = 0;
+            is >> n;
+            es.resize(n);
+            for (Entry & e : es)
+                is >> e.key >> e.size;
         }
+    }
+
+    void assign_state(const MachineModel & m) { t_ = m.t_; }
+
+    std::size_t size(IdT id) const { return t_[id].size(); }
+
+    bool update(IdT id, OpT op, KeyT k = KeyT(), SizeT s = SizeT()) {
+
+        if (report_)
+            LIBTBX_REPORT_DEBUG("Applying state update:"
+                                << "{"
+                                << "id:" << id << ","
+                                << "op:" << op_to_string(op) << ","
+                                << std::hex
+                                << "key:" << k << ","
+                                << "size:" << s
+                                << "}");
 
         bool error = false;
         switch (op) {
@@ -367,80 +400,124 @@ private:
         return OP_CLEAR;
     }
 
+    bool report_;
+    bool retain_state_{false};
     ListTable t_;
 };
 
-struct SortedListsTb : libtb::TopLevel
+struct SortedListsTb : libtbx::TopLevel
 {
     //
     using UUT = Vsorted_lists;
-    SC_HAS_PROCESS(SortedListsTb);
-    SortedListsTb(sc_core::sc_module_name mn = "t")
+    LIBTBX_HAS_PROCESS(SortedListsTb);
+    SortedListsTb(libtbx::ModuleName mn = "t")
         : uut_("uut")
 #define __construct_signal(__name, __type)      \
           , __name##_(#__name)
           PORTS(__construct_signal)
 #undef __construct_signal
     {
-        SC_THREAD(t_update);
-        SC_METHOD(m_query_checker);
-        dont_initialize();
-        sensitive << e_tb_sample();
+        co_.spawn(t_update());
+        LIBTBX_SAMPLE(m_query_checker);
 
-        uut_.clk(clk());
-        uut_.rst(rst());
+        LIBTBX_BIND_UUT(uut_);
 #define __bind_signal(__name, __type)           \
-        uut_.__name(__name##_);
+        LIBTBX_BIND_PORT(uut_, __name);
         PORTS(__bind_signal)
 #undef __bind_signals
+
+#define __probe_signal(__name, __type)          \
+        wave_.probe(#__name, __name##_);
+        PORTS(__probe_signal)
+#undef __probe_signal
     }
 
     void m_query_checker() {
+        LIBTBX_PROFILE_SCOPE("checker");
+        wave_.sample();
         if (qry_resp_vld_r_) {
 
-            if (r_list_.size() == 0)
-            {
-                LIBTB_REPORT_ERROR("Unexpected response");
-                return;
-            }
-
-            const QueryResult expected = r_list_.front();
-            r_list_.pop_front();
             const QueryResult actual{
                 qry_key_r_, qry_size_r_, qry_listsize_r_, qry_error_r_};
-            if (!(expected == actual)) {
-                std::stringstream ss;
-                ss << "Mismatch detected: "
-                   << " Actual:" << actual.to_string()
-                   << " Expected:" << expected.to_string();
-                LIBTB_REPORT_ERROR(ss.str());
-
-                // Report LIST state.
-                for (auto & e : expected.dbg_)
-                    LIBTB_REPORT_DEBUG(e.to_string());
-            } else {
-                std::stringstream ss;
-                ss << "Query response validated:" << actual.to_string();
-                LIBTB_REPORT_DEBUG(ss.str());
+
+            // Retrieve the expected response from the reference model;
+            // should none be outstanding, the scoreboard reports underflow.
+            //
+            if (ref_pipe_.outstanding() != 0)
+                r_list_.push(ref_pipe_.pop());
+            const bool pass = r_list_.check(
+                actual, [&](const QueryResult & expected) {
+                    tx_qry_resp_.record_error(
+                        actual.key, actual.size, actual.listsize, actual.error);
+
+                    std::stringstream ss;
+                    ss << "Mismatch detected: "
+                       << " Actual:" << actual.to_string()
+                       << " Expected:" << expected.to_string();
+                    LIBTB_REPORT_ERROR(ss.str());
+
+                    // Report LIST state.
+                    for (auto & e : expected.dbg_)
+                        LIBTBX_REPORT_DEBUG(e.to_string());
+                });
+            if (pass) {
+                tx_qry_resp_.record(
+                    actual.key, actual.size, actual.listsize, actual.error);
+                LIBTBX_REPORT_DEBUG("Query response validated:"
+                                    << actual.to_string());
             }
 
         }
     }
 
-    void t_update() {
-        t_wait_reset_done();
-        LIBTB_REPORT_INFO("Setting configuration...");
+    // Knobs which determine the checkpointed (configured) state; a checkpoint
+    // is restored only with the values by which it was written.
+    //
+    static std::string checkpoint_config() {
+        std::stringstream ss;
+        ss << "updates=" << OPT_UPDATES.get();
+        return ss.str();
+    }
 
-        for (int i = 0; i < OPT_UPDATES; i++)
-        {
-            const Update u = mdl_.random_update();
-            b_issue_upt(u.id, u.op, u.k, u.s);
+    // Update stimulus is issued every cycle, therefore it is run as a
+    // coroutine rather than as a thread (see <libtbx/coro.h>).
+    //
+    libtbx::Task t_update() {
+        co_await co_.reset_done();
+        if (const char * fn = libtbx::Checkpoint::restore_path()) {
+            LIBTB_REPORT_INFO("Restoring configuration...");
+            libtbx::Checkpoint::restore(
+                fn, checkpoint_config(), uut_,
+                [this](libtbx::RestoreStream & is) { mdl_.restore(is); });
+
+            // No command has yet been issued to the reference model, hence
+            // it may be safely initialized from the simulation thread.
+            //
+            ref_.assign_state(mdl_);
+        } else {
+            LIBTB_REPORT_INFO("Setting configuration...");
+            for (int i = 0; i < OPT_UPDATES; i++)
+            {
+                const Update u = random_update();
+                co_await b_issue_upt(u.id, u.op, u.k, u.s);
+            }
+            co_await co_.posedge(10);
         }
         LIBTB_REPORT_INFO("Configuration set...");
-
-        t_wait_posedge_clk(10);
         update_done_event_.notify();
 
+        // Snapshot the configured state before any query is issued, such that
+        // subsequent runs may proceed directly to query stimulus.
+        //
+        if (const char * fn = libtbx::Checkpoint::save_path()) {
+            if (!libtbx::Checkpoint::restore_path()) {
+                LIBTB_REPORT_INFO("Saving configuration...");
+                libtbx::Checkpoint::save(
+                    fn, checkpoint_config(), uut_,
+                    [this](libtbx::SaveStream & os) { mdl_.save(os); });
+            }
+        }
+
         for (int i = 0; i < OPT_UPDATES; i++)
         {
             if (i % 100 == 0) {
@@ -450,14 +527,24 @@ struct SortedListsTb : libtb::TopLevel
                 // complete before any attempt to (potentially) modify their
                 // state.
                 //
-                t_wait_posedge_clk(10);
+                co_await co_.posedge(10);
             }
 
-            const Update u = mdl_.random_update();
-            b_issue_upt(u.id, u.op, u.k, u.s);
+            const Update u = random_update();
+            co_await b_issue_upt(u.id, u.op, u.k, u.s);
         }
     }
 
+    Update random_update() {
+        LIBTBX_PROFILE_SCOPE("stimulus");
+        return mdl_.random_update();
+    }
+
+    Query random_query() {
+        LIBTBX_PROFILE_SCOPE("stimulus");
+        return mdl_.random_query();
+    }
+
     void upt_idle() {
         upt_vld_ = false;
         upt_id_ = IdT();
@@ -466,17 +553,24 @@ struct SortedListsTb : libtb::TopLevel
         upt_size_ = SizeT();
     }
 
-    void b_issue_upt(IdT id, OpT op, KeyT k = KeyT(), SizeT s = SizeT()) {
+    libtbx::Task b_issue_upt(IdT id, OpT op, KeyT k = KeyT(),
+                             SizeT s = SizeT()) {
         upt_vld_ = true;
         upt_id_ = id;
         upt_op_ = op;
         upt_key_ = k;
         upt_size_ = s;
-        t_wait_posedge_clk(1);
-        mdl_.update(id, op, k, s);
+        co_await co_.posedge(1);
+        tx_upt_.record(id, op, k, s);
+        cx_upt_.sample(op, mdl_.size(id));
+        {
+            LIBTBX_PROFILE_SCOPE("model");
+            mdl_.update(id, op, k, s);
+            ref_pipe_.push(ModelCmd{false, Update{id, op, k, s}, Query()});
+        }
         upt_idle();
 #ifdef ISSUE_DELAY
-        t_wait_posedge_clk(1);
+        co_await co_.posedge(1);
 #endif
     }
 
@@ -491,9 +585,17 @@ struct SortedListsTb : libtb::TopLevel
         qry_id_ = q.id;
         qry_level_ = q.l;
         t_wait_posedge_clk();
-        QueryResult qr;
-        mdl_.apply_query(q, qr);
-        r_list_.push_back(qr);
+        tx_qry_.record(q.id, q.l);
+        cx_qry_.sample(q.l, mdl_.size(q.id));
+        LIBTBX_REPORT_DEBUG("Issuing Query:"
+                            << "{"
+                            << "id:" << q.id << ","
+                            << "level:" << q.l
+                            << "}");
+        {
+            LIBTBX_PROFILE_SCOPE("model");
+            ref_pipe_.push_expect(ModelCmd{true, Update(), q});
+        }
         qry_idle();
     }
 
@@ -501,19 +603,51 @@ struct SortedListsTb : libtb::TopLevel
         wait(update_done_event_);
         LIBTB_REPORT_INFO("Stimulus starts...");
 
-        for (int i = 0; i < OPT_QUERIES; i++) {
-            const Query q = mdl_.random_query();
+        // The verbosity is queried here, upon the simulation thread, and
+        // published to the model thread by the first query issued.
+        //
+        ref_.retain_state(libtbx::debug_enabled());
+
+        for (int i = 0; (i < OPT_QUERIES) && !libtbx::coverage_done(); i++) {
+            const Query q = random_query();
             b_issue_qry(q);
         }
         t_wait_posedge_clk(10);
         LIBTB_REPORT_INFO("Stimulus ends...");
         return false;
     }
+    // Stimulus is generated against mdl_. The (costly) query evaluation is
+    // performed by a second model, ref_, upon its own thread when
+    // OPT_MODEL_THREAD, which receives the same updates in the same order.
+    //
     MachineModel mdl_;
-    std::deque<QueryResult> r_list_;
-    sc_core::sc_event update_done_event_;
+    MachineModel ref_{false};
+    libtbx::ModelPipeline<ModelCmd, QueryResult> ref_pipe_{
+        [this](const ModelCmd & c, QueryResult & qr) {
+            if (c.is_query)
+                ref_.apply_query(c.q, qr);
+            else
+                ref_.update(c.u.id, c.u.op, c.u.k, c.u.s);
+        }, OPT_MODEL_THREAD};
+    libtbx::Scoreboard<QueryResult> r_list_{"qry_resp"};
+    // Operations and queries by the occupancy of the addressed list,
+    // including those which error (ADD to a full list, query beyond the
+    // end of a list).
+    //
+    libtbx::Coverpoint cp_op_{"op", {"CLEAR", "ADD", "DELETE", "REPLACE"}};
+    libtbx::Coverpoint cp_listsize_{"listsize", {"0", "1", "2", "3", "4"}};
+    libtbx::Coverpoint cp_level_{"level", {"0", "1", "2", "3"}};
+    libtbx::Cross cx_upt_{"op_x_listsize", {&cp_op_, &cp_listsize_}};
+    libtbx::Cross cx_qry_{"level_x_listsize", {&cp_level_, &cp_listsize_}};
+    libtbx::WaveRing wave_;
+    libtbx::Event update_done_event_;
+    libtbx::CoScheduler co_{*this};
+    libtbx::TxInterface tx_upt_{"upt", {"id", "op", "key", "size"}};
+    libtbx::TxInterface tx_qry_{"qry", {"id", "level"}};
+    libtbx::TxInterface tx_qry_resp_{
+        "qry_resp", {"key", "size", "listsize", "error"}};
 #define __declare_signal(__name, __type)        \
-    sc_core::sc_signal<__type> __name##_;
+    libtbx::Signal<__type> __name##_;
     PORTS(__declare_signal)
 #undef __declare_signal
     UUT uut_;
@@ -522,5 +656,5 @@ struct SortedListsTb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<SortedListsTb>(argc, argv).start();
+    return libtbx::Sim<SortedListsTb>(argc, argv).start();
 }
@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <sstream>
 #include "Vusing_full_adders.h"
 #define PORTS(__func)                           \
@@ -82,5 +83,5 @@ struct UsingFullAddersTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<UsingFullAddersTb>(argc, argv).start();
+    return libtbx::Sim<UsingFullAddersTb>(argc, argv).start();
 }
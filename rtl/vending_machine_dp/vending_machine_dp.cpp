@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vvending_machine_dp.h"
 
 #define PORTS(__func)                           \
@@ -54,9 +55,9 @@ struct VendingMachineTb : libtb::TopLevel
           PORTS(__construct_signals)
 #undef __construct_signals
     {
-        SC_THREAD(t_emit_serve_done);
-        SC_THREAD(t_emit_change_done);
-        SC_THREAD(t_dispense);
+        co_.spawn(t_emit_serve_done());
+        co_.spawn(t_emit_change_done());
+        co_.spawn(t_dispense());
 
         uut_.clk(clk());
         uut_.rst(rst());
@@ -98,46 +99,49 @@ struct VendingMachineTb : libtb::TopLevel
 
     void reset_change_count() { change_count_ = 0; }
 
-    void t_dispense() {
+    // The client and service agents below are run as coroutines (see
+    // <libtbx/coro.h>); each waits upon a rising edge of its request.
+    //
+    libtbx::Task t_dispense() {
 
         const int DLY = 2;
         while (1) {
             client_dispense_ = false;
-            wait(client_enough_r_.posedge_event());
-            for (int i = 0; i < DLY; i++)
-                t_wait_posedge_clk();
+            co_await co_.rising([this]() { return client_enough_r_.read(); });
+            co_await co_.posedge(DLY);
             client_dispense_ = true;
-            t_wait_posedge_clk();
+            co_await co_.posedge();
             client_dispense_ = false;
         }
     }
 
-    void t_emit_change_done() {
+    libtbx::Task t_emit_change_done() {
         const int DLY = 4;
         while (1) {
             change_done_ = false;
-            wait(change_emit_dime_r_.posedge_event());
-            for (int i = 0; i < DLY; i++)
-                t_wait_posedge_clk();
+            co_await co_.rising(
+                [this]() { return change_emit_dime_r_.read(); });
+            co_await co_.posedge(DLY);
             change_count_++;
             change_done_ = true;
-            t_wait_posedge_clk();
+            co_await co_.posedge();
         }
     }
 
-    void t_emit_serve_done() {
+    libtbx::Task t_emit_serve_done() {
         const int DLY = 3;
         while (1) {
             serve_done_ = false;
-            wait(serve_emit_irn_bru_r_.posedge_event());
-            for (int i = 0; i < DLY; i++)
-                t_wait_posedge_clk();
+            co_await co_.rising(
+                [this]() { return serve_emit_irn_bru_r_.read(); });
+            co_await co_.posedge(DLY);
             serve_done_ = true;
-            t_wait_posedge_clk();
+            co_await co_.posedge();
         }
     }
 
     unsigned change_count_{0};
+    libtbx::CoScheduler co_{*this};
 #define __declare_signals(__name, __type)       \
     sc_core::sc_signal<__type> __name##_;
     PORTS(__declare_signals)
@@ -148,5 +152,5 @@ struct VendingMachineTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<VendingMachineTb>(argc, argv).start();
+    return libtbx::Sim<VendingMachineTb>(argc, argv).start();
 }
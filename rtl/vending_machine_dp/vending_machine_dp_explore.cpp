@@ -0,0 +1,222 @@
+//========================================================================== //
+// Copyright (c) 2016-17, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtb.h>
+#include <libtbx.h>
+#include <sstream>
+#include "Vvending_machine_dp.h"
+
+// Exhaustive exploration of the reachable states of the answer from reset
+// (see <libtbx/explore.h>). In each cycle, the client may insert a coin or
+// request an item, or the serve and change agents may complete their current
+// request; the timing of each is therefore explored alongside the sequence of
+// coins.
+//
+using UUT = Vvending_machine_dp;
+
+// Price of the item, in nickels. Each pulse of change_emit_dime_r returns one
+// nickel of credit.
+//
+constexpr unsigned PRICE = 8;
+
+// Cycles within which an expected vend or change must be observed.
+//
+constexpr unsigned STALL = 4;
+
+enum Choice : std::size_t {
+    IDLE, NICKEL, DIME, QUARTER, DISPENSE, SERVE_DONE, CHANGE_DONE
+};
+
+// Reference model of a purchase, from the perspective of the client and the
+// serve and change agents. Coins are inserted only between purchases, and only
+// until the credit reaches the price; the client then holds client_dispense
+// until the item is served. The agents complete each request (serve_done,
+// change_done) no earlier than the cycle after it was withdrawn. The item must
+// be served once per purchase, and the credit in excess of the price returned
+// as change.
+//
+struct Reference {
+    enum Request : unsigned { NONE, EMITTED, WAITING, DONE };
+
+    unsigned credit{0};
+    unsigned owed{0};
+    bool dispense{false};
+    unsigned serve{NONE};
+    unsigned change{NONE};
+    unsigned cooldown{0};
+    unsigned stall{0};
+
+    bool purchasing() const { return dispense || (serve != NONE); }
+
+    bool allows(std::size_t choice) const {
+        switch (choice) {
+        case NICKEL:
+        case DIME:
+        case QUARTER:
+            return !purchasing() && (cooldown == 0) && (credit < PRICE);
+        case DISPENSE:
+            return !purchasing() && (credit >= PRICE);
+        case SERVE_DONE:
+            return (serve == WAITING);
+        case CHANGE_DONE:
+            return (change == WAITING) && (owed != 0);
+        default:
+            return true;
+        }
+    }
+
+    std::uint64_t key() const {
+        return (std::uint64_t{credit} << 32) | (owed << 24) | (dispense << 20) |
+               (serve << 16) | (change << 12) | (cooldown << 8) | stall;
+    }
+};
+
+void tick(UUT & uut)
+{
+    uut.clk = 1;
+    uut.eval();
+    uut.clk = 0;
+    uut.eval();
+}
+
+void drive_idle(UUT & uut)
+{
+    uut.clk = 0;
+    uut.client_nickel = 0;
+    uut.client_dime = 0;
+    uut.client_quarter = 0;
+    uut.client_dispense = 0;
+    uut.serve_done = 0;
+    uut.change_done = 0;
+}
+
+// Apply CHOICE for one cycle and check the outputs of the model against the
+// reference; return the first violation, if any.
+//
+std::string step(UUT & uut, Reference & ref, std::size_t choice)
+{
+    std::ostringstream ss;
+
+    uut.client_nickel = (choice == NICKEL);
+    uut.client_dime = (choice == DIME);
+    uut.client_quarter = (choice == QUARTER);
+    uut.client_dispense = ref.dispense || (choice == DISPENSE);
+    uut.serve_done = (choice == SERVE_DONE);
+    uut.change_done = (choice == CHANGE_DONE);
+    tick(uut);
+
+    if (ref.cooldown != 0)
+        --ref.cooldown;
+    switch (choice) {
+    case NICKEL: ref.credit += 1; break;
+    case DIME: ref.credit += 2; break;
+    case QUARTER: ref.credit += 5; break;
+    case DISPENSE: ref.dispense = true; break;
+    case SERVE_DONE:
+        ref.serve = Reference::DONE;
+        ref.owed = ref.credit - PRICE;
+        ref.credit = 0;
+        if (ref.owed == 0)
+            ref.serve = Reference::NONE;
+        break;
+    case CHANGE_DONE: ref.change = Reference::NONE; break;
+    default: break;
+    }
+
+    // Vend: once per purchase, upon request, having been paid.
+    //
+    if (uut.serve_emit_irn_bru_r) {
+        if (!ref.dispense || (ref.serve != Reference::NONE))
+            return "item served without request";
+        if (ref.credit < PRICE) {
+            ss << "item served with credit " << (ref.credit * 5) << "c";
+            return ss.str();
+        }
+        ref.dispense = false;
+        ref.serve = Reference::EMITTED;
+    } else if (ref.serve == Reference::EMITTED) {
+        ref.serve = Reference::WAITING;
+    }
+
+    // Change: one nickel per pulse, up to the credit in excess of the price.
+    //
+    if (uut.change_emit_dime_r) {
+        if ((ref.serve != Reference::DONE) || (ref.change != Reference::NONE))
+            return "change returned outside of a purchase (overpaid)";
+        if (--ref.owed != 0) {
+            ref.change = Reference::EMITTED;
+        } else {
+            // The purchase is complete; coins are accepted once the machine
+            // has returned to its initial state.
+            ref = Reference{};
+            ref.cooldown = 2;
+        }
+    } else if (ref.change == Reference::EMITTED) {
+        ref.change = Reference::WAITING;
+    }
+
+    // Between purchases, client_enough_r denotes that the price has been met.
+    //
+    if (!ref.purchasing() && (ref.cooldown == 0) &&
+        (uut.client_enough_r != (ref.credit >= PRICE))) {
+        ss << "client_enough_r=" << int{uut.client_enough_r}
+           << " with credit " << (ref.credit * 5) << "c";
+        return ss.str();
+    }
+
+    // An awaited vend or change must not stall.
+    //
+    const bool awaiting =
+        (ref.dispense && (ref.serve == Reference::NONE)) ||
+        ((ref.serve == Reference::DONE) && (ref.change == Reference::NONE));
+    ref.stall = awaiting ? (ref.stall + 1) : 0;
+    if ((ref.stall > STALL) && ref.dispense)
+        return "item not served";
+    if (ref.stall > STALL) {
+        ss << "change underpaid by " << (ref.owed * 5) << "c";
+        return ss.str();
+    }
+    return std::string{};
+}
+
+int sc_main(int argc, char **argv)
+{
+    return libtbx::explore<UUT, Reference>(
+        argc, argv,
+        {"idle", "nickel", "dime", "quarter", "dispense", "serve_done",
+         "change_done"},
+        [](UUT & uut) {
+            drive_idle(uut);
+            uut.rst = 1;
+            uut.eval();
+            tick(uut);
+            tick(uut);
+            uut.rst = 0;
+            uut.eval();
+        },
+        step, drive_idle);
+}
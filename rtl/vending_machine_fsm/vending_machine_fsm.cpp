@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include "Vvending_machine_fsm.h"
 
 #define PORTS(__func)                           \
@@ -38,12 +39,15 @@ struct VendingMachineTb : libtb::TopLevel
 {
     SC_HAS_PROCESS(VendingMachineTb);
     VendingMachineTb(sc_core::sc_module_name mn = "t")
-        : uut_("uut")
+        : reset_("reset", *this), uut_("uut")
 #define __construct_signals(__name, __type)     \
         , __name##_(#__name)
     PORTS(__construct_signals)
 #undef __construct_signals
     {
+        tests_.add("test_0", [this]() { test_0(); });
+        tests_.add("test_1", [this]() { test_1(); });
+
         SC_METHOD(m_sample_vend);
         sensitive << vend_.posedge_event();
         dont_initialize();
@@ -53,7 +57,7 @@ struct VendingMachineTb : libtb::TopLevel
         dont_initialize();
 
         uut_.clk(clk());
-        uut_.rst(rst());
+        uut_.rst(reset_.rst());
 #define __bind_signals(__name, __type)          \
         uut_.__name(__name##_);
         PORTS(__bind_signals)
@@ -75,8 +79,7 @@ struct VendingMachineTb : libtb::TopLevel
     bool run_test()
     {
         LIBTB_REPORT_INFO("Stimulus starts...");
-        test_0();
-        test_1();
+        tests_.run();
         LIBTB_REPORT_INFO("Stimulus ends");
 
         return false;
@@ -116,6 +119,14 @@ struct VendingMachineTb : libtb::TopLevel
         LIBTB_ASSERT_ERROR(vend_n_ == 1);
     }
 
+    // Return the FSM to its initial state between tests.
+    //
+    void b_reset()
+    {
+        idle();
+        reset_.b_reset();
+    }
+
     void idle()
     {
         nickel_ = false;
@@ -143,6 +154,8 @@ struct VendingMachineTb : libtb::TopLevel
         idle();
     }
 
+    libtbx::TestReset reset_;
+    libtbx::TestList tests_{[this]() { b_reset(); }};
     unsigned value_{0};
     unsigned vend_n_{0}, change_n_{0};
 #define __declare_signals(__name, __type)       \
@@ -156,5 +169,5 @@ struct VendingMachineTb : libtb::TopLevel
 int sc_main (int argc, char **argv)
 {
     using namespace libtb;
-    return LibTbSim<VendingMachineTb>(argc, argv).start();
+    return libtbx::Sim<VendingMachineTb>(argc, argv).start();
 }
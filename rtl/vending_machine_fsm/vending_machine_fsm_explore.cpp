@@ -0,0 +1,118 @@
+//========================================================================== //
+// Copyright (c) 2016, Stephen Henry
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//========================================================================== //
+
+#include <libtb.h>
+#include <libtbx.h>
+#include <sstream>
+#include "Vvending_machine_fsm.h"
+
+// Exhaustive exploration of the reachable states of the answer from reset
+// (see <libtbx/explore.h>). In each cycle, a nickel or a dime is inserted, or
+// neither.
+//
+using UUT = Vvending_machine_fsm;
+
+// Price of the item, and the value of each coin, in nickels.
+//
+constexpr unsigned PRICE = 8;
+
+enum Choice : std::size_t { IDLE, NICKEL, DIME };
+
+// Reference model: the credit inserted since the last vend. The item is vended
+// in the cycle in which the credit reaches the price, with change should it
+// exceed it; the machine then returns to its initial state and ignores any
+// coin inserted in the following cycle. Coins are offered in every cycle, so
+// that a coin dropped after a vend is explored; should it be credited, the
+// early vend that follows is a violation.
+//
+struct Reference {
+    unsigned credit{0};
+    bool vended{false};
+
+    bool allows(std::size_t) const { return true; }
+
+    std::uint64_t key() const {
+        return (credit << 1) | (vended ? 1 : 0);
+    }
+};
+
+void tick(UUT & uut)
+{
+    uut.clk = 1;
+    uut.eval();
+    uut.clk = 0;
+    uut.eval();
+}
+
+void drive_idle(UUT & uut)
+{
+    uut.clk = 0;
+    uut.nickel = 0;
+    uut.dime = 0;
+}
+
+int sc_main(int argc, char **argv)
+{
+    return libtbx::explore<UUT, Reference>(
+        argc, argv, {"idle", "nickel", "dime"},
+        [](UUT & uut) {
+            drive_idle(uut);
+            uut.rst = 1;
+            uut.eval();
+            tick(uut);
+            tick(uut);
+            uut.rst = 0;
+            uut.eval();
+        },
+        [](UUT & uut, Reference & ref, std::size_t choice) {
+            uut.nickel = (choice == NICKEL);
+            uut.dime = (choice == DIME);
+            tick(uut);
+
+            bool vend = false;
+            if (ref.vended) {
+                // Any coin inserted in this cycle is dropped.
+                ref.vended = false;
+            } else {
+                ref.credit += (choice == NICKEL) ? 1 : (choice == DIME) ? 2 : 0;
+                vend = (ref.credit >= PRICE);
+            }
+            const bool change = vend && (ref.credit > PRICE);
+
+            std::ostringstream ss;
+            if (uut.vend != vend || uut.change != change)
+                ss << "vend=" << int{uut.vend} << " change=" << int{uut.change}
+                   << " (expected vend=" << vend << " change=" << change
+                   << " with credit " << (ref.credit * 5) << "c)";
+            if (vend) {
+                ref.credit = 0;
+                ref.vended = true;
+            }
+            return ss.str();
+        },
+        drive_idle);
+}
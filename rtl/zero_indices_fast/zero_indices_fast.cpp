@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <deque>
 #include <sstream>
 #include <bitset>
@@ -75,25 +76,56 @@ struct ZeroIndicesFastTb : libtb::TopLevel
 #undef __bind_signals
   }
 
+  // Coverage bin of a vector with ZEROS clear bits: the corner cases, or
+  // otherwise.
+  //
+  static std::size_t zeros_bin(std::size_t zeros)
+  {
+    switch (zeros) {
+    case 1: return 0;
+    case 2: return 1;
+    case 127: return 3;
+    case 128: return 4;
+    }
+    return 2;
+  }
+
   Stimulus construct_stimulus()
   {
+    // Bits are set with probability (100 - ZERO_PROBABILITY)% or, for one
+    // vector in eight, the number of zeros is chosen from the corner cases.
+    // A vector without zeros is not issued: the design responds to each
+    // vector at least once. The expected indices are those of the clear
+    // bits, in ascending order.
+    //
+    static const std::size_t ZERO_CORNERS[] = {1, 2, 127, 128};
+    std::uint64_t w[2];
+    if (rng_.bounded(8) == 0)
+      libtbx::random_bits_count(rng_, w, 128,
+                                128 - ZERO_CORNERS[rng_.bounded(4)]);
+    else
+      libtbx::random_bits_density(rng_, w, 128,
+                                  (100 - ZERO_PROBABILITY) / 100.0);
+
     Stimulus s;
-    for (int i = 0; i < 128; i++)
-      s.v[i] = (libtb::random_integer_in_range(100) < (100 - ZERO_PROBABILITY));
+    for (int i = 0; i < 4; i++)
+      s.v.set_word(i, static_cast<uint32_t>(w[i / 2] >> (32 * (i % 2))));
+    for (int i = 0; i < 2; i++) {
+      for (std::uint64_t z = ~w[i]; z != 0; z &= (z - 1))
+        s.p.push_back(64 * i + __builtin_ctzll(z));
+    }
 
-    VectorT v = s.v;
-    for (int i = 0; i < 128; i++) {
-      if (!v[i])
-        s.p.push_back(i);
+    const std::size_t zeros = s.p.size();
+    if (zeros != 0) {
+      cp_zeros_.sample(zeros_bin(zeros));
+      cp_first_zero_word_.sample(s.p.front() / 32);
     }
     return s;
   }
 
   void b_issue_in(const Stimulus & s)
   {
-    std::stringstream ss;
-    ss << "Issuing vector: " << s.v.to_string(SC_BIN);
-    LIBTB_REPORT_DEBUG(ss.str());
+    LIBTBX_REPORT_DEBUG("Issuing vector: " << s.v.to_string(SC_BIN));
 
     in_start_ = true;
     in_vector_ = s.v;
@@ -106,7 +138,7 @@ struct ZeroIndicesFastTb : libtb::TopLevel
     t_wait_reset_done();
     LIBTB_REPORT_INFO("Stimulus starts...");
 
-    for (int i = 0; i < 10000; i++) {
+    for (int i = 0; (i < 10000) && !libtbx::coverage_done(); i++) {
       const Stimulus c = construct_stimulus();
       q_.push_back(c);
       b_issue_in(c);
@@ -145,13 +177,15 @@ struct ZeroIndicesFastTb : libtb::TopLevel
           ;
         LIBTB_REPORT_ERROR(ss.str());
       } else {
-        std::stringstream ss;
-        ss << "Validated index: " << std::dec << actual;
-        LIBTB_REPORT_DEBUG(ss.str());
+        LIBTBX_REPORT_DEBUG("Validated index: " << std::dec << actual);
       }
     }
   }
 
+  libtbx::Rng rng_;
+  libtbx::Coverpoint cp_zeros_{"zeros", {"1", "2", "3-126", "127", "128"}};
+  libtbx::Coverpoint cp_first_zero_word_{"first_zero_word",
+                                         {"0", "1", "2", "3"}};
   RespQueueT q_{};
 #define __declare_signal(__name, __type)        \
   sc_core::sc_signal<__type> __name##_;
@@ -163,5 +197,5 @@ struct ZeroIndicesFastTb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
   using namespace libtb;
-  return LibTbSim<ZeroIndicesFastTb>(argc, argv).start();
+  return libtbx::Sim<ZeroIndicesFastTb>(argc, argv).start();
 }
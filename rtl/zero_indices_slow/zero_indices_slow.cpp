@@ -26,6 +26,7 @@
 //========================================================================== //
 
 #include <libtb.h>
+#include <libtbx.h>
 #include <deque>
 #include <sstream>
 #include <bitset>
@@ -73,8 +74,16 @@ struct ZeroIndicesSlowTb : libtb::TopLevel
 
   Stimulus construct_stimulus()
   {
+    // One vector in four has a corner-case number of zeros. A vector without
+    // zeros is not issued: the design responds to each vector at least once.
+    //
+    static const std::size_t ZERO_CORNERS[] = {1, 2, 31, 32};
     Stimulus s;
-    s.v = libtb::random<uint32_t>();
+    if (rng_.bounded(4) == 0)
+      s.v = libtbx::random_bits_count<uint32_t>(
+          rng_, 32 - ZERO_CORNERS[rng_.bounded(4)]);
+    else
+      s.v = libtbx::random_bits_density<uint32_t>(rng_, 0.5);
 
     uint32_t v = ~s.v;
     for (int i = 0; v; i++) {
@@ -87,10 +96,7 @@ struct ZeroIndicesSlowTb : libtb::TopLevel
 
   void b_issue_in(const Stimulus & s)
   {
-    std::stringstream ss;
-    bitset<32> b(s.v);
-    ss << "Issuing vector: " << b.to_string();
-    LIBTB_REPORT_DEBUG(ss.str());
+    LIBTBX_REPORT_DEBUG("Issuing vector: " << bitset<32>(s.v).to_string());
     
     in_start_ = true;
     in_vector_ = s.v;
@@ -143,13 +149,12 @@ struct ZeroIndicesSlowTb : libtb::TopLevel
           ;
         LIBTB_REPORT_ERROR(ss.str());
       } else {
-        std::stringstream ss;
-        ss << "Validated index: " << std::dec << actual;
-        LIBTB_REPORT_DEBUG(ss.str());
+        LIBTBX_REPORT_DEBUG("Validated index: " << std::dec << actual);
       }
     }
   }
 
+  libtbx::Rng rng_;
   RespQueueT q_{};
 #define __declare_signal(__name, __type)        \
   sc_core::sc_signal<__type> __name##_;
@@ -161,5 +166,5 @@ struct ZeroIndicesSlowTb : libtb::TopLevel
 int sc_main(int argc, char **argv)
 {
   using namespace libtb;
-  return LibTbSim<ZeroIndicesSlowTb>(argc, argv).start();
+  return libtbx::Sim<ZeroIndicesSlowTb>(argc, argv).start();
 }
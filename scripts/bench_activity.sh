@@ -0,0 +1,62 @@
+##========================================================================== //
+## Copyright (c) 2016, Stephen Henry
+## All rights reserved.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+## * Redistributions of source code must retain the above copyright notice, this
+##   list of conditions and the following disclaimer.
+##
+## * Redistributions in binary form must reproduce the above copyright notice,
+##   this list of conditions and the following disclaimer in the documentation
+##   and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+##========================================================================== //
+
+# Compare the switching activity, as reported by libtbx, of the baseline
+# implementation of an answer (<answer>_activity_baseline) against that of the
+# answer itself (<answer>_activity) under the same test.
+#
+#   bench_activity.sh <baseline_exe> <answer_exe> <report>
+#
+
+if [ $# -ne 3 ]; then
+    echo "usage: $0 <baseline_exe> <answer_exe> <report>"
+    exit 1
+fi
+
+activity() {
+    $1 | grep '^\[libtbx\] activity toggles=' | tail -n 1 | \
+        sed -n 's/.* toggles_per_cycle=\([0-9.]*\).*/\1/p'
+}
+
+baseline=$(activity $1)
+answer=$(activity $2)
+if [ -z "${baseline}" ] || [ -z "${answer}" ]; then
+    echo "no switching activity reported"
+    exit 1
+fi
+
+reduction=$(awk -v a=${answer} -v b=${baseline} \
+                'BEGIN { if (a > 0) printf "%.2f", b / a; else print "-" }')
+
+{
+    printf "%-32s %18s\n" "TARGET" "TOGGLES/CYCLE"
+    printf "%-32s %18s\n" $(basename $1) ${baseline}
+    printf "%-32s %18s\n" $(basename $2) ${answer}
+    printf "%-32s %18s\n" "reduction" ${reduction}
+} | tee $3
+
+exit 0
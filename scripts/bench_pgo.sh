@@ -0,0 +1,61 @@
+##========================================================================== //
+## Copyright (c) 2016, Stephen Henry
+## All rights reserved.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+## * Redistributions of source code must retain the above copyright notice, this
+##   list of conditions and the following disclaimer.
+##
+## * Redistributions in binary form must reproduce the above copyright notice,
+##   this list of conditions and the following disclaimer in the documentation
+##   and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+##========================================================================== //
+
+# Record the simulation rate, as reported by libtbx, of an answer before
+# (<answer>_fast) and after (<answer>_pgo) profile-guided optimization.
+#
+#   bench_pgo.sh <before_exe> <after_exe> <report>
+#
+
+if [ $# -ne 3 ]; then
+    echo "usage: $0 <before_exe> <after_exe> <report>"
+    exit 1
+fi
+
+rate() {
+    $1 | grep '^\[libtbx\]' | tail -n 1 | \
+        sed -n 's/.* cycles_per_s=\([0-9.]*\).*/\1/p'
+}
+
+before=$(rate $1)
+after=$(rate $2)
+if [ -z "${before}" ] || [ -z "${after}" ]; then
+    echo "no run statistics reported"
+    exit 1
+fi
+
+speedup=$(awk -v a=${after} -v b=${before} \
+              'BEGIN { if (b > 0) printf "%.2f", a / b; else print "-" }')
+
+{
+    printf "%-32s %14s\n" "TARGET" "CYCLES/s"
+    printf "%-32s %14s\n" $(basename $1) ${before}
+    printf "%-32s %14s\n" $(basename $2) ${after}
+    printf "%-32s %14s\n" "speedup" ${speedup}
+} | tee $3
+
+exit 0
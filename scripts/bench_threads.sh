@@ -0,0 +1,65 @@
+##========================================================================== //
+## Copyright (c) 2016, Stephen Henry
+## All rights reserved.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+## * Redistributions of source code must retain the above copyright notice, this
+##   list of conditions and the following disclaimer.
+##
+## * Redistributions in binary form must reproduce the above copyright notice,
+##   this list of conditions and the following disclaimer in the documentation
+##   and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+##========================================================================== //
+
+# Run each of the executables passed as arguments (typically the
+# <answer>_t<N> variants of an answer, verilated with --threads N) and tabulate
+# the simulation rate reported by libtbx. Designs whose rate does not improve
+# with N are dominated by the SystemC kernel rather than by model evaluation.
+#
+
+if [ $# -eq 0 ]; then
+    echo "usage: $0 <answer>_t<N> [<answer>_t<N> ...]"
+    exit 1
+fi
+
+printf "%-32s %8s %14s %10s %14s %8s\n" \
+       "TARGET" "THREADS" "CYCLES" "WALL(s)" "CYCLES/s" "SPEEDUP"
+
+base=""
+for exe in "$@"; do
+    name=$(basename ${exe})
+    threads=${name##*_t}
+
+    stats=$(${exe} | grep '^\[libtbx\]' | tail -n 1)
+    if [ -z "${stats}" ]; then
+        echo "${name}: no run statistics reported"
+        exit 1
+    fi
+
+    cycles=$(echo ${stats} | sed -n 's/.* cycles=\([0-9.]*\).*/\1/p')
+    wall=$(echo ${stats} | sed -n 's/.* wall_s=\([0-9.]*\).*/\1/p')
+    rate=$(echo ${stats} | sed -n 's/.* cycles_per_s=\([0-9.]*\).*/\1/p')
+
+    [ -z "${base}" ] && base=${rate}
+    speedup=$(awk -v r=${rate} -v b=${base} \
+                  'BEGIN { if (b > 0) printf "%.2f", r / b; else print "-" }')
+
+    printf "%-32s %8s %14s %10s %14s %8s\n" \
+           ${name} ${threads} ${cycles} ${wall} ${rate} ${speedup}
+done
+
+exit 0
@@ -0,0 +1,79 @@
+##========================================================================== //
+## Copyright (c) 2016, Stephen Henry
+## All rights reserved.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+## * Redistributions of source code must retain the above copyright notice, this
+##   list of conditions and the following disclaimer.
+##
+## * Redistributions in binary form must reproduce the above copyright notice,
+##   this list of conditions and the following disclaimer in the documentation
+##   and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+##========================================================================== //
+
+# Profile-guided optimization training step. Run the instrumented executable
+# <answer>_pgo_gen (that is, the answer's own test) and transfer the resultant
+# profiles to the object directories of the profile-guided build.
+#
+#   pgo_train.sh <exe> <stamp> <gen_dir> <use_dir> [<gen_dir> <use_dir> ...]
+#
+# Profiles are emitted by GCC as one .gcda file alongside each instrumented
+# object. The profile-guided build compiles identical sources to identically
+# named objects, therefore the profiles are copied verbatim. Objects of the
+# profile-guided build are removed so that they are rebuilt against the new
+# profile.
+#
+
+if [ $# -lt 4 ]; then
+    echo "usage: $0 <exe> <stamp> <gen_dir> <use_dir> [<gen_dir> <use_dir> ...]"
+    exit 1
+fi
+
+exe=$1
+stamp=$2
+shift 2
+
+# Discard profiles accumulated by previous training runs.
+#
+for dir in $(printf "%s\n" "$@" | awk 'NR % 2 == 1'); do
+    find ${dir} -name '*.gcda' -exec rm -f {} +
+done
+
+if ! ${exe} > ${stamp}.log; then
+    cat ${stamp}.log
+    echo "$(basename ${exe}): training run failed"
+    exit 1
+fi
+grep '^\[libtbx\]' ${stamp}.log
+
+while [ $# -ge 2 ]; do
+    gen=$1
+    use=$2
+    shift 2
+
+    mkdir -p ${use}
+    find ${use} -name '*.gcda' -exec rm -f {} +
+    find ${use} \( -name '*.o' -o -name '*.a' \) -exec rm -f {} +
+    (cd ${gen} && find . -name '*.gcda') | while read f; do
+        mkdir -p ${use}/$(dirname ${f})
+        cp ${gen}/${f} ${use}/${f}
+    done
+done
+
+touch ${stamp}
+
+exit 0
@@ -0,0 +1,195 @@
+##========================================================================== //
+## Copyright (c) 2016, Stephen Henry
+## All rights reserved.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+## * Redistributions of source code must retain the above copyright notice, this
+##   list of conditions and the following disclaimer.
+##
+## * Redistributions in binary form must reproduce the above copyright notice,
+##   this list of conditions and the following disclaimer in the documentation
+##   and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+
+# Run each of the executables passed as arguments over a range of seeds, in
+# parallel, and aggregate the results (pass/fail, wall-clock time, simulated
+# cycles and, where reported, functional coverage per seed) into regress.json
+# and regress.xml (JUnit) in the output directory. Per-seed logs are retained
+# in <dir>/logs.
+#
+# Executables are scheduled longest first: by their mean wall-clock time in the
+# previous regression, where known (<dir>/history), otherwise in the order
+# given.
+#
+#   -j JOBS   Number of concurrent simulations (default: number of cores).
+#   -n SEEDS  Number of seeds per executable (default: 100).
+#   -s SEED   First seed (default: 1).
+#   -o DIR    Output directory (default: regress).
+#
+# The seed is passed to each executable as '${REGRESS_SEED_ARG} <seed>', where
+# REGRESS_SEED_ARG defaults to '--seed'.
+#
+
+seed_arg=${REGRESS_SEED_ARG:---seed}
+
+# Run a single seed; invoked (in parallel) by xargs.
+#
+if [ "$1" = "--job" ]; then
+    dir=$2
+    exe=$3
+    seed=$4
+    name=$(basename ${exe})
+    log=${dir}/logs/${name}.${seed}.log
+
+    start=$(date +%s.%N)
+    ${exe} ${seed_arg} ${seed} > ${log} 2>&1
+    rc=$?
+    end=$(date +%s.%N)
+
+    stats=$(grep '^\[libtbx\] cycles=' ${log} | tail -n 1)
+    cycles=$(echo ${stats} | sed -n 's/.* cycles=\([0-9.e+]*\).*/\1/p')
+    coverage=$(grep '^\[libtbx\] coverage covered=' ${log} | tail -n 1 | \
+               sed -n 's/.* pct=\([0-9.]*\).*/\1/p')
+    wall=$(awk -v s=${start} -v e=${end} 'BEGIN { printf "%.3f", e - s }')
+    echo "${name} ${seed} ${rc} ${wall} ${cycles:-0} ${coverage:-null}" \
+         > ${dir}/results/${name}.${seed}
+    exit 0
+fi
+
+jobs=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)
+seeds=100
+first=1
+dir=regress
+
+while getopts "j:n:s:o:" opt; do
+    case ${opt} in
+        j) [ "${OPTARG}" -gt 0 ] && jobs=${OPTARG} ;;
+        n) seeds=${OPTARG} ;;
+        s) first=${OPTARG} ;;
+        o) dir=${OPTARG} ;;
+        *) exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -eq 0 ]; then
+    echo "usage: $0 [-j JOBS] [-n SEEDS] [-s SEED] [-o DIR] <exe> [<exe> ...]"
+    exit 1
+fi
+
+rm -rf ${dir}/logs ${dir}/results
+mkdir -p ${dir}/logs ${dir}/results
+dir=$(cd ${dir} && pwd)
+
+# Order executables by decreasing expected run time. Those without history are
+# assumed to be long running, and retain their relative order.
+#
+idx=0
+for exe in "$@"; do
+    idx=$((idx + 1))
+    name=$(basename ${exe})
+    weight=""
+    [ -f ${dir}/history ] && \
+        weight=$(awk -v n=${name} '$1 == n { print $2 }' ${dir}/history)
+    [ -z "${weight}" ] && weight=$((1000000000 - idx))
+    echo "${weight} ${exe}"
+done | sort -s -g -r -k 1,1 | while read weight exe; do
+    seed=${first}
+    while [ ${seed} -lt $((first + seeds)) ]; do
+        echo "${exe} ${seed}"
+        seed=$((seed + 1))
+    done
+done > ${dir}/jobs
+
+echo "Running $(wc -l < ${dir}/jobs) simulations across ${jobs} jobs..."
+start=$(date +%s.%N)
+xargs -P ${jobs} -n 2 sh $0 --job ${dir} < ${dir}/jobs
+end=$(date +%s.%N)
+
+# Aggregate per-seed results; those without a result are reported as failed.
+#
+while read exe seed; do
+    name=$(basename ${exe})
+    if [ -f ${dir}/results/${name}.${seed} ]; then
+        cat ${dir}/results/${name}.${seed}
+    else
+        echo "${name} ${seed} -1 0 0 null"
+    fi
+done < ${dir}/jobs > ${dir}/results.txt
+
+awk -v dir=${dir} -v jobs=${jobs} -v seeds=${seeds} \
+    -v start=${start} -v end=${end} '
+{
+    name[NR] = $1; seed[NR] = $2; rc[NR] = $3; wall[NR] = $4; cycles[NR] = $5;
+    coverage[NR] = $6;
+    if ($3 != 0) { failed++; fails[$1]++ }
+    tests[$1]++; time[$1] += $4;
+    if (!($1 in order)) { order[$1] = ++answers; answer[answers] = $1 }
+}
+END {
+    json = dir "/regress.json";
+    printf "{\n  \"jobs\": %d,\n  \"seeds\": %d,\n", jobs, seeds > json;
+    printf "  \"wall_s\": %.3f,\n", end - start > json;
+    printf "  \"passed\": %d,\n  \"failed\": %d,\n", NR - failed, failed > json;
+    printf "  \"results\": [\n" > json;
+    for (i = 1; i <= NR; i++)
+        printf "    {\"answer\": \"%s\", \"seed\": %d, \"status\": \"%s\", " \
+               "\"rc\": %d, \"wall_s\": %s, \"cycles\": %s, " \
+               "\"coverage\": %s}%s\n",
+               name[i], seed[i], (rc[i] == 0) ? "pass" : "fail", rc[i],
+               wall[i], cycles[i], coverage[i], (i < NR) ? "," : "" > json;
+    printf "  ]\n}\n" > json;
+
+    xml = dir "/regress.xml";
+    printf "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" > xml;
+    printf "<testsuites tests=\"%d\" failures=\"%d\" time=\"%.3f\">\n",
+           NR, failed, end - start > xml;
+    for (a = 1; a <= answers; a++) {
+        n = answer[a];
+        printf "  <testsuite name=\"%s\" tests=\"%d\" failures=\"%d\" " \
+               "time=\"%.3f\">\n", n, tests[n], fails[n], time[n] > xml;
+        for (i = 1; i <= NR; i++) {
+            if (name[i] != n)
+                continue;
+            printf "    <testcase classname=\"%s\" name=\"seed_%d\" " \
+                   "time=\"%s\"", n, seed[i], wall[i] > xml;
+            if (rc[i] == 0)
+                printf "/>\n" > xml;
+            else
+                printf ">\n      <failure message=\"rc=%d\">%s/logs/%s.%d.log" \
+                       "</failure>\n    </testcase>\n",
+                       rc[i], dir, n, seed[i] > xml;
+        }
+        printf "  </testsuite>\n" > xml;
+    }
+    printf "</testsuites>\n" > xml;
+
+    hist = dir "/history";
+    printf "" > hist;
+    for (a = 1; a <= answers; a++) {
+        n = answer[a];
+        printf "%s %.3f\n", n, time[n] / tests[n] > hist;
+    }
+
+    printf "%-32s %8s %8s %12s\n", "TARGET", "SEEDS", "FAILED", "MEAN(s)";
+    for (a = 1; a <= answers; a++) {
+        n = answer[a];
+        printf "%-32s %8d %8d %12.3f\n", n, tests[n], fails[n], time[n] / tests[n];
+    }
+    printf "%d passed, %d failed in %.3fs (%s/regress.json)\n",
+           NR - failed, failed, end - start, dir;
+    exit (failed != 0);
+}' ${dir}/results.txt
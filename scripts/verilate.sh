@@ -25,6 +25,12 @@
 ## POSSIBILITY OF SUCH DAMAGE.
 ##========================================================================== //
 
+# Verilation is a tracked build step; a failure of Verilator or of the compile
+# of its output must fail the step, rather than leave a stale model to be
+# linked.
+#
+set -e
+
 if [ -z "${VERILATOR_INCLUDE}" ]; then
     echo "VERILATOR_INCLUDE not defined"
     exit 1
@@ -45,16 +51,45 @@ if [ -z ${ANSWER} ]; then
     exit 1
 fi
 
-# Invoke Verilator
+# Invoke Verilator. VERILATOR_FLAGS selects the model variant (for example,
+# tracing instrumentation); it defaults to a traced model when not defined.
+# VERILATOR_MODE selects between SystemC (--sc, the default) and plain C++
+# (--cc) models.
 #
-${VERILATOR_EXE} --sc ${VERILATOR_INCLUDE} \
-                 --trace --trace-structs \
+${VERILATOR_EXE} ${VERILATOR_MODE:---sc} ${VERILATOR_INCLUDE} \
+                 ${VERILATOR_FLAGS---trace-fst --trace-structs} \
                  --Mdir ${VERILATED_OBJ} \
                  ${VERILATOR_OPTIONS} \
                  ${CMAKE_CURRENT_SOURCE_DIR}/${ANSWER}.sv
 
-# Build generated source
+# Build generated source. VERILATOR_CFLAGS, when defined, overrides the
+# optimization options applied to the generated model.
 #
-make -C ${VERILATED_OBJ} -f "V${ANSWER}.mk"
+if [ -z "${VERILATOR_CFLAGS}" ]; then
+    make -C ${VERILATED_OBJ} -f "V${ANSWER}.mk"
+else
+    make -C ${VERILATED_OBJ} -f "V${ANSWER}.mk" \
+         OPT_FAST="${VERILATOR_CFLAGS}" OPT_SLOW="${VERILATOR_CFLAGS}"
+fi
 
-exit 0
+# Multithreaded and plain C++ models must be linked against a Verilator
+# runtime compiled with the same configuration (VL_THREADED, SystemC). When
+# VERILATOR_RUNTIME is defined, the runtime objects required by the model (as
+# enumerated by the generated makefile) are built and archived alongside the
+# model.
+#
+# As above, VERILATOR_CFLAGS overrides the optimization options only when
+# defined.
+#
+RUNTIME_MK='libverilated_rt.a: $(VK_GLOBAL_OBJS)
+	$(AR) rcs $@ $^'
+if [ -n "${VERILATOR_RUNTIME}" ]; then
+    if [ -z "${VERILATOR_CFLAGS}" ]; then
+        printf "%s\n" "${RUNTIME_MK}" | \
+            make -C ${VERILATED_OBJ} -f "V${ANSWER}.mk" -f - libverilated_rt.a
+    else
+        printf "%s\n" "${RUNTIME_MK}" | \
+            make -C ${VERILATED_OBJ} -f "V${ANSWER}.mk" -f - libverilated_rt.a \
+                 OPT_FAST="${VERILATOR_CFLAGS}" OPT_SLOW="${VERILATOR_CFLAGS}"
+    fi
+fi